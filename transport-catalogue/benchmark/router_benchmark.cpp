@@ -0,0 +1,918 @@
+// Замеры производительности маршрутизации.
+// На вход (stdin) подаётся JSON в формате make_base: base_requests и routing_settings.
+
+#include "dijkstra_router.h"
+#include "geo.h"
+#include "json_reader.h"
+#include "min_plus.h"
+#include "router.h"
+#include "thread_pool.h"
+#include "transport_catalogue.h"
+#include "transport_router.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std::literals;
+
+namespace {
+
+using TransportRouter = transport_router::TransportRouter;
+using Graph = TransportRouter::Graph;
+using Router = TransportRouter::Router;
+
+constexpr size_t QUERY_COUNT = 1000;
+
+// возвращает время выполнения func в секундах
+template <typename Func>
+double MeasureSeconds(Func&& func) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    return duration.count();
+}
+
+// сравнивает таблицы маршрутов с точностью до бита
+bool IsIdentical(const Router::RoutesInternalData& lhs, const Router::RoutesInternalData& rhs) {
+    const auto& lhs_weights = lhs.GetWeights();
+    const auto& rhs_weights = rhs.GetWeights();
+    return lhs_weights.size() == rhs_weights.size()
+            && std::memcmp(lhs_weights.data(), rhs_weights.data(), lhs_weights.size() * sizeof(double)) == 0
+            && lhs.GetPrevEdges() == rhs.GetPrevEdges();
+}
+
+void BenchmarkFloydWarshall(const Graph& graph) {
+    std::cout << "Floyd-Warshall, vertices: "sv << graph.GetVertexCount()
+              << ", edges: "sv << graph.GetEdgeCount() << '\n';
+
+    std::optional<Router> sequential;
+    const double sequential_time = MeasureSeconds([&] {
+        sequential.emplace(graph, true, Router::Algorithm::SEQUENTIAL);
+    });
+    std::optional<Router> blocked;
+    const double blocked_time = MeasureSeconds([&] {
+        blocked.emplace(graph, true, Router::Algorithm::BLOCKED);
+    });
+
+    std::cout << "  sequential: "sv << sequential_time << " s\n"sv;
+    std::cout << "  blocked:    "sv << blocked_time << " s ("sv
+              << concurrency::ThreadPool().GetThreadCount() << " threads), speedup "sv
+              << sequential_time / blocked_time << '\n';
+    std::cout << "  identical:  "sv
+              << (IsIdentical(sequential->GetRoutesInternalData(), blocked->GetRoutesInternalData())
+                  ? "yes"sv : "NO"sv) << '\n';
+
+    std::optional<Router> dijkstra;
+    const double dijkstra_time = MeasureSeconds([&] {
+        dijkstra.emplace(graph, true, Router::Algorithm::DIJKSTRA);
+    });
+    // суммы весов складываются в другом порядке, поэтому сравнение - с допуском
+    const auto& blocked_weights = blocked->GetRoutesInternalData().GetWeights();
+    const auto& dijkstra_weights = dijkstra->GetRoutesInternalData().GetWeights();
+    size_t mismatch_count = 0;
+    for (size_t i = 0; i < blocked_weights.size(); ++i) {
+        const bool is_reachable = blocked_weights[i] != Router::RoutesInternalData::UNREACHABLE;
+        if (is_reachable != (dijkstra_weights[i] != Router::RoutesInternalData::UNREACHABLE)
+                || (is_reachable && std::abs(blocked_weights[i] - dijkstra_weights[i])
+                                    > 1e-6 * std::max(1.0, blocked_weights[i]))) {
+            ++mismatch_count;
+        }
+    }
+    std::cout << "  dijkstra:   "sv << dijkstra_time << " s (per source, "sv
+              << concurrency::ThreadPool().GetThreadCount() << " threads), speedup over blocked "sv
+              << blocked_time / dijkstra_time << ", mismatches "sv << mismatch_count << '\n';
+}
+
+// восстановление маршрутов по таблице всех пар: новый вектор рёбер на каждый запрос
+// и общий буфер вызывающего
+void BenchmarkPathReconstruction(const Graph& graph) {
+    constexpr size_t ROUTE_COUNT = 200000;
+    const size_t vertex_count = graph.GetVertexCount();
+    std::cout << "Path reconstruction, routes: "sv << ROUTE_COUNT << '\n';
+    if (vertex_count == 0) {
+        return;
+    }
+    const Router router(graph);
+    std::vector<std::pair<graph::VertexId, graph::VertexId>> pairs;
+    pairs.reserve(ROUTE_COUNT);
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<graph::VertexId> distribution(0, vertex_count - 1);
+    for (size_t i = 0; i < ROUTE_COUNT; ++i) {
+        pairs.emplace_back(distribution(generator), distribution(generator));
+    }
+
+    size_t allocating_edges = 0;
+    const double allocating_time = MeasureSeconds([&] {
+        for (const auto& [from, to] : pairs) {
+            if (auto route = router.BuildRoute(from, to)) {
+                allocating_edges += route->edges.size();
+            }
+        }
+    });
+    size_t buffer_edges = 0;
+    std::vector<graph::EdgeId> edges;
+    const double buffer_time = MeasureSeconds([&] {
+        for (const auto& [from, to] : pairs) {
+            if (router.BuildRoute(from, to, edges)) {
+                buffer_edges += edges.size();
+            }
+        }
+    });
+    std::cout << "  new vector:    "sv << allocating_time << " s\n"sv;
+    std::cout << "  caller buffer: "sv << buffer_time << " s, speedup "sv << allocating_time / buffer_time << '\n';
+    std::cout << "  identical:     "sv << (allocating_edges == buffer_edges ? "yes"sv : "NO"sv) << '\n';
+}
+
+// суммарное время маршрута, -1 если маршрута нет
+double GetRouteTime(const std::optional<TransportRouter::TransportRoute>& route) {
+    if (!route) {
+        return -1;
+    }
+    double result = 0;
+    for (const auto& edge : *route) {
+        result += edge.total_time;
+    }
+    return result;
+}
+
+// случайные пары различных остановок, одинаковые для всех запусков
+std::vector<std::pair<std::string, std::string>>
+MakeQueries(const transport_catalogue::TransportCatalogue& catalogue) {
+    std::vector<std::string> stop_names;
+    for (const auto& [name, stop] : catalogue.GetStops()) {
+        stop_names.emplace_back(name);
+    }
+    std::vector<std::pair<std::string, std::string>> queries;
+    if (stop_names.size() < 2) {
+        return queries;
+    }
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<size_t> distribution(0, stop_names.size() - 1);
+    while (queries.size() < QUERY_COUNT) {
+        const size_t from = distribution(generator);
+        const size_t to = distribution(generator);
+        if (from != to) {
+            queries.emplace_back(stop_names[from], stop_names[to]);
+        }
+    }
+    return queries;
+}
+
+// выполняет запросы, сохраняя время каждого маршрута; возвращает время выполнения в секундах
+double RunQueries(TransportRouter& router, const std::vector<std::pair<std::string, std::string>>& queries,
+                  std::vector<double>& route_times) {
+    route_times.resize(queries.size());
+    return MeasureSeconds([&] {
+        for (size_t i = 0; i < queries.size(); ++i) {
+            route_times[i] = GetRouteTime(router.BuildRoute(queries[i].first, queries[i].second));
+        }
+    });
+}
+
+size_t CountMismatches(const std::vector<double>& expected, const std::vector<double>& actual) {
+    size_t mismatch_count = 0;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (std::abs(expected[i] - actual[i]) > 1e-6 * std::max(1.0, std::abs(expected[i]))) {
+            ++mismatch_count;
+        }
+    }
+    return mismatch_count;
+}
+
+// построение графа (рёбра автобусов строятся в пуле потоков), лучшее из нескольких запусков
+void BenchmarkBuildEdges(const transport_catalogue::TransportCatalogue& catalogue,
+                         TransportRouter::RoutingSettings settings) {
+    constexpr size_t RUN_COUNT = 5;
+    settings.engine = TransportRouter::Engine::DIJKSTRA;
+    double best_time = std::numeric_limits<double>::infinity();
+    size_t edge_count = 0;
+    for (size_t run = 0; run < RUN_COUNT; ++run) {
+        TransportRouter router(catalogue, settings);
+        best_time = std::min(best_time, MeasureSeconds([&] {
+            router.InitRouter();
+        }));
+        edge_count = router.GetGraph().GetEdgeCount();
+    }
+    std::cout << "Graph construction, edges: "sv << edge_count << '\n';
+    std::cout << "  build: "sv << best_time << " s ("sv << concurrency::ThreadPool().GetThreadCount()
+              << " threads), "sv << static_cast<double>(edge_count) / best_time / 1e6 << " M edges/s\n"sv;
+}
+
+// длины всех маршрутов по пройденным расстояниям автобусов и суммированием перегонов из каталога
+// (так длина считалась в GetRouteInfo и время перегонов при построении графа)
+void BenchmarkRouteDistances(const transport_catalogue::TransportCatalogue& catalogue) {
+    constexpr size_t REPEAT_COUNT = 20;
+    const auto& routes = catalogue.GetRoutes();
+    long long prefix_sum = 0;
+    const double prefix_time = MeasureSeconds([&] {
+        for (size_t repeat = 0; repeat < REPEAT_COUNT; ++repeat) {
+            for (const auto& [name, bus] : routes) {
+                const size_t last = bus->stops.size() - 1;
+                prefix_sum += bus->GetDistance(0, last);
+                if (bus->route_type == domain::RouteType::LINEAR) {
+                    prefix_sum += bus->GetDistance(last, 0);
+                }
+            }
+        }
+    });
+    long long lookup_sum = 0;
+    const double lookup_time = MeasureSeconds([&] {
+        for (size_t repeat = 0; repeat < REPEAT_COUNT; ++repeat) {
+            for (const auto& [name, bus] : routes) {
+                for (size_t i = 1; i < bus->stops.size(); ++i) {
+                    lookup_sum += catalogue.GetDistance(bus->stops[i - 1]->name, bus->stops[i]->name);
+                }
+                if (bus->route_type == domain::RouteType::LINEAR) {
+                    for (size_t i = bus->stops.size(); i > 1; --i) {
+                        lookup_sum += catalogue.GetDistance(bus->stops[i - 1]->name, bus->stops[i - 2]->name);
+                    }
+                }
+            }
+        }
+    });
+    std::cout << "Route lengths, buses: "sv << routes.size() << ", repeats "sv << REPEAT_COUNT << '\n';
+    std::cout << "  prefix sums:      "sv << prefix_time << " s\n"sv;
+    std::cout << "  distance lookups: "sv << lookup_time << " s\n"sv;
+    std::cout << "  identical:        "sv << (prefix_sum == lookup_sum ? "yes"sv : "NO"sv) << '\n';
+}
+
+// обход всех рёбер графа по спискам инцидентности и в сжатом представлении
+void BenchmarkGraphLayout(const Graph& graph) {
+    constexpr size_t PASS_COUNT = 200;
+    std::cout << "Graph traversal, edges: "sv << graph.GetEdgeCount() << " ("sv
+              << sizeof(TransportRouter::GraphEdge) << " bytes each), passes: "sv << PASS_COUNT << '\n';
+
+    double incidence_sum = 0;
+    const double incidence_time = MeasureSeconds([&] {
+        for (size_t pass = 0; pass < PASS_COUNT; ++pass) {
+            for (graph::VertexId vertex = 0; vertex < graph.GetVertexCount(); ++vertex) {
+                for (const graph::EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
+                    const auto& edge = graph.GetEdge(edge_id);
+                    incidence_sum += edge.weight.total_time + static_cast<double>(edge.to);
+                }
+            }
+        }
+    });
+    double frozen_sum = 0;
+    const double frozen_time = MeasureSeconds([&] {
+        for (size_t pass = 0; pass < PASS_COUNT; ++pass) {
+            for (graph::VertexId vertex = 0; vertex < graph.GetVertexCount(); ++vertex) {
+                for (const auto& edge : graph.GetOutgoingEdges(vertex)) {
+                    frozen_sum += edge.weight.total_time + static_cast<double>(edge.to);
+                }
+            }
+        }
+    });
+
+    std::cout << "  incidence lists: "sv << incidence_time << " s\n"sv;
+    std::cout << "  frozen (CSR):    "sv << frozen_time << " s, speedup "sv << incidence_time / frozen_time << '\n';
+    std::cout << "  identical:       "sv << (incidence_sum == frozen_sum ? "yes"sv : "NO"sv) << '\n';
+}
+
+// память под рёбра, списки инцидентности и сжатое представление графа
+template <typename Id>
+size_t EstimateGraphBytes(const graph::DirectedWeightedGraph<transport_router::RouteWeight, Id>& graph) {
+    using IdGraph = graph::DirectedWeightedGraph<transport_router::RouteWeight, Id>;
+    using IdEdge = graph::Edge<transport_router::RouteWeight, Id>;
+    return graph.GetEdgeCount() * (sizeof(IdEdge) + sizeof(Id) + sizeof(typename IdGraph::OutgoingEdge))
+            + (graph.GetVertexCount() + 1) * sizeof(Id);
+}
+
+// поиски Дейкстры по всему графу из нескольких вершин, возвращает сумму весов для сверки
+template <typename Id>
+double RunFullSearches(const graph::DirectedWeightedGraph<transport_router::RouteWeight, Id>& graph,
+                       size_t source_count) {
+    double result = 0;
+    std::vector<std::optional<transport_router::RouteWeight>> weights;
+    for (graph::VertexId from = 0; from < std::min(source_count, graph.GetVertexCount()); ++from) {
+        graph::ComputeShortestPathWeights(graph, from, weights);
+        for (const auto& weight : weights) {
+            result += weight ? weight->total_time : 0.0;
+        }
+    }
+    return result;
+}
+
+// 32-битные номера вершин и рёбер против 64-битных: память графа и поиски по нему
+void BenchmarkGraphIdWidth(const Graph& graph) {
+    constexpr size_t SOURCE_COUNT = 200;
+    using WideGraph = graph::DirectedWeightedGraph<transport_router::RouteWeight, uint64_t>;
+    WideGraph wide_graph(graph.GetVertexCount());
+    for (const auto& edge : graph.GetEdges()) {
+        wide_graph.AddEdge({edge.from, edge.to, edge.weight});
+    }
+    wide_graph.Freeze();
+    std::cout << "Graph id width, vertices: "sv << graph.GetVertexCount() << ", edges: "sv
+              << graph.GetEdgeCount() << ", searches: "sv << std::min(SOURCE_COUNT, graph.GetVertexCount()) << '\n';
+
+    double narrow_sum = 0;
+    const double narrow_time = MeasureSeconds([&] {
+        narrow_sum = RunFullSearches(graph, SOURCE_COUNT);
+    });
+    double wide_sum = 0;
+    const double wide_time = MeasureSeconds([&] {
+        wide_sum = RunFullSearches(wide_graph, SOURCE_COUNT);
+    });
+
+    std::cout << "  64-bit ids: "sv << EstimateGraphBytes(wide_graph) << " bytes, searches "sv << wide_time << " s\n"sv;
+    std::cout << "  32-bit ids: "sv << EstimateGraphBytes(graph) << " bytes, searches "sv << narrow_time
+              << " s, speedup "sv << wide_time / narrow_time << '\n';
+    std::cout << "  identical:  "sv << (narrow_sum == wide_sum ? "yes"sv : "NO"sv) << '\n';
+}
+
+// средняя разность номеров концов ребра: чем она меньше, тем ближе в памяти данные соседних вершин
+double ComputeMeanEdgeSpan(const Graph& graph) {
+    double result = 0;
+    for (const auto& edge : graph.GetEdges()) {
+        result += std::abs(static_cast<double>(edge.to) - static_cast<double>(edge.from));
+    }
+    return result / static_cast<double>(std::max<size_t>(graph.GetEdgeCount(), 1));
+}
+
+// нумерация остановок в порядке Мортона против случайной (как в порядке хэш-таблицы):
+// граф с переставленными номерами остановок и поиски Дейкстры по всему графу
+void BenchmarkStopOrder(const Graph& graph, size_t stop_count) {
+    constexpr size_t SOURCE_COUNT = 200;
+    std::vector<TransportRouter::GraphId> new_ids(graph.GetVertexCount());
+    for (size_t id = 0; id < new_ids.size(); ++id) {
+        new_ids[id] = static_cast<TransportRouter::GraphId>(id);
+    }
+    std::mt19937 generator(42);
+    std::shuffle(new_ids.begin(), new_ids.begin() + static_cast<std::ptrdiff_t>(stop_count), generator);
+    Graph shuffled_graph(graph.GetVertexCount());
+    for (const auto& edge : graph.GetEdges()) {
+        shuffled_graph.AddEdge({new_ids[edge.from], new_ids[edge.to], edge.weight});
+    }
+    shuffled_graph.Freeze();
+    std::cout << "Stop order, stops: "sv << stop_count << ", searches: "sv
+              << std::min(SOURCE_COUNT, graph.GetVertexCount()) << '\n';
+
+    // из одних и тех же остановок, поэтому суммы весов совпадают
+    const auto run_searches = [&](const Graph& searched_graph, bool is_shuffled) {
+        double result = 0;
+        std::vector<std::optional<transport_router::RouteWeight>> weights;
+        for (graph::VertexId from = 0; from < std::min(SOURCE_COUNT, stop_count); ++from) {
+            graph::ComputeShortestPathWeights(searched_graph, is_shuffled ? new_ids[from] : from, weights);
+            for (const auto& weight : weights) {
+                result += weight ? weight->total_time : 0.0;
+            }
+        }
+        return result;
+    };
+    double shuffled_sum = 0;
+    const double shuffled_time = MeasureSeconds([&] {
+        shuffled_sum = run_searches(shuffled_graph, true);
+    });
+    double ordered_sum = 0;
+    const double ordered_time = MeasureSeconds([&] {
+        ordered_sum = run_searches(graph, false);
+    });
+
+    std::cout << "  random: mean edge span "sv << ComputeMeanEdgeSpan(shuffled_graph)
+              << ", searches "sv << shuffled_time << " s\n"sv;
+    std::cout << "  morton: mean edge span "sv << ComputeMeanEdgeSpan(graph)
+              << ", searches "sv << ordered_time << " s, speedup "sv << shuffled_time / ordered_time << '\n';
+    std::cout << "  identical: "sv << (std::abs(shuffled_sum - ordered_sum) <= 1e-6 * std::max(1.0, ordered_sum)
+                                       ? "yes"sv : "NO"sv) << '\n';
+}
+
+// сравнивает модели графа STOP_PAIRS и ON_BOARD: размер графа и запросы Дейкстры
+void BenchmarkGraphModels(const transport_catalogue::TransportCatalogue& catalogue,
+                          TransportRouter::RoutingSettings settings) {
+    const auto queries = MakeQueries(catalogue);
+    std::cout << "On-board vs stop pairs graph model, queries: "sv << queries.size() << '\n';
+    if (queries.empty()) {
+        return;
+    }
+
+    settings.engine = TransportRouter::Engine::DIJKSTRA;
+    std::vector<double> stop_pairs_times;
+    for (const auto graph_model : {TransportRouter::GraphModel::STOP_PAIRS, TransportRouter::GraphModel::ON_BOARD}) {
+        settings.graph_model = graph_model;
+        TransportRouter router(catalogue, settings);
+        const double build_time = MeasureSeconds([&] {
+            router.InitRouter();
+        });
+        std::vector<double> route_times;
+        const double query_time = RunQueries(router, queries, route_times);
+
+        const bool is_on_board = graph_model == TransportRouter::GraphModel::ON_BOARD;
+        std::cout << (is_on_board ? "  on board:   "sv : "  stop pairs: "sv)
+                  << "vertices "sv << router.GetGraph().GetVertexCount()
+                  << ", edges "sv << router.GetGraph().GetEdgeCount()
+                  << ", build "sv << build_time << " s, queries "sv << query_time << " s\n"sv;
+        if (is_on_board) {
+            std::cout << "  mismatches: "sv << CountMismatches(stop_pairs_times, route_times) << '\n';
+        } else {
+            stop_pairs_times = std::move(route_times);
+        }
+    }
+}
+
+// граф модели ON_BOARD со сжатием цепочек и без него: размер графа, построение и запросы
+void BenchmarkChainCompression(const transport_catalogue::TransportCatalogue& catalogue,
+                               TransportRouter::RoutingSettings settings) {
+    const auto queries = MakeQueries(catalogue);
+    std::cout << "On-board chain compression, queries: "sv << queries.size() << '\n';
+    if (queries.empty()) {
+        return;
+    }
+
+    settings.graph_model = TransportRouter::GraphModel::ON_BOARD;
+    for (const auto engine : {TransportRouter::Engine::DIJKSTRA, TransportRouter::Engine::CONTRACTION_HIERARCHY}) {
+        settings.engine = engine;
+        std::vector<double> full_times;
+        for (const bool compress_chains : {false, true}) {
+            settings.compress_chains = compress_chains;
+            TransportRouter router(catalogue, settings);
+            const double build_time = MeasureSeconds([&] {
+                router.InitRouter();
+            });
+            std::vector<double> route_times;
+            const double query_time = RunQueries(router, queries, route_times);
+
+            std::cout << (engine == TransportRouter::Engine::DIJKSTRA ? "  dijkstra"sv : "  hierarchy"sv)
+                      << (compress_chains ? ", compressed: "sv : ", full:       "sv)
+                      << "vertices "sv << router.GetGraph().GetVertexCount()
+                      << ", edges "sv << router.GetGraph().GetEdgeCount()
+                      << ", build "sv << build_time << " s, queries "sv << query_time << " s\n"sv;
+            if (compress_chains) {
+                std::cout << "  mismatches: "sv << CountMismatches(full_times, route_times) << '\n';
+            } else {
+                full_times = std::move(route_times);
+            }
+        }
+    }
+}
+
+// сравнивает Дейкстру и A*: время запросов и число извлечённых из очереди вершин
+void BenchmarkAStar(const transport_catalogue::TransportCatalogue& catalogue,
+                    TransportRouter::RoutingSettings settings) {
+    const auto queries = MakeQueries(catalogue);
+    std::cout << "A* vs Dijkstra, queries: "sv << queries.size() << '\n';
+    if (queries.empty()) {
+        return;
+    }
+
+    settings.engine = TransportRouter::Engine::DIJKSTRA;
+    TransportRouter dijkstra(catalogue, settings);
+    dijkstra.InitRouter();
+    settings.engine = TransportRouter::Engine::A_STAR;
+    TransportRouter a_star(catalogue, settings);
+    a_star.InitRouter();
+
+    std::vector<double> dijkstra_times;
+    const double dijkstra_time = RunQueries(dijkstra, queries, dijkstra_times);
+    std::vector<double> a_star_times;
+    const double a_star_time = RunQueries(a_star, queries, a_star_times);
+
+    const double query_count = static_cast<double>(queries.size());
+    std::cout << "  dijkstra: "sv << dijkstra_time << " s, settled per query "sv
+              << static_cast<double>(dijkstra.GetDijkstraRouter()->GetSettledCount()) / query_count << '\n';
+    std::cout << "  a_star:   "sv << a_star_time << " s, settled per query "sv
+              << static_cast<double>(a_star.GetDijkstraRouter()->GetSettledCount()) / query_count << '\n';
+    std::cout << "  mismatches: "sv << CountMismatches(dijkstra_times, a_star_times) << '\n';
+}
+
+// сравнивает метки опорных вершин с иерархией сжатия: построение, размер меток и время запросов веса
+void BenchmarkHubLabels(const transport_catalogue::TransportCatalogue& catalogue,
+                        TransportRouter::RoutingSettings settings) {
+    const auto queries = MakeQueries(catalogue);
+    std::cout << "Hub labels vs contraction hierarchy, queries: "sv << queries.size() << '\n';
+    if (queries.empty()) {
+        return;
+    }
+
+    settings.hub_labels = false;
+    settings.engine = TransportRouter::Engine::CONTRACTION_HIERARCHY;
+    TransportRouter hierarchy(catalogue, settings);
+    const double hierarchy_build_time = MeasureSeconds([&] {
+        hierarchy.InitRouter();
+    });
+    // граф строится и для меток, время построения меток - разность с построением графа
+    settings.engine = TransportRouter::Engine::DIJKSTRA;
+    TransportRouter dijkstra(catalogue, settings);
+    const double graph_build_time = MeasureSeconds([&] {
+        dijkstra.InitRouter();
+    });
+    settings.hub_labels = true;
+    TransportRouter labels(catalogue, settings);
+    const double labels_build_time = MeasureSeconds([&] {
+        labels.InitRouter();
+    }) - graph_build_time;
+
+    const auto run_time_queries = [&queries](TransportRouter& router, std::vector<double>& route_times) {
+        route_times.resize(queries.size());
+        return MeasureSeconds([&] {
+            for (size_t i = 0; i < queries.size(); ++i) {
+                route_times[i] = router.GetRouteTime(queries[i].first, queries[i].second).value_or(-1);
+            }
+        });
+    };
+    std::vector<double> hierarchy_times;
+    const double hierarchy_time = run_time_queries(hierarchy, hierarchy_times);
+    std::vector<double> labels_times;
+    const double labels_time = run_time_queries(labels, labels_times);
+
+    const auto& hub_labels = *labels.GetHubLabels();
+    const size_t vertex_count = hub_labels.GetVertexCount();
+    const size_t label_bytes = hub_labels.GetLabelCount() * (sizeof(uint32_t) + sizeof(double))
+            + 2 * (vertex_count + 1) * sizeof(size_t);
+    const double query_count = static_cast<double>(queries.size());
+    std::cout << "  hierarchy: build "sv << hierarchy_build_time << " s, "sv
+              << hierarchy_time / query_count * 1e6 << " us per query\n"sv;
+    std::cout << "  labels:    build "sv << labels_build_time << " s, "sv
+              << labels_time / query_count * 1e6 << " us per query\n"sv;
+    std::cout << "  labels per vertex: "sv
+              << static_cast<double>(hub_labels.GetLabelCount()) / static_cast<double>(std::max<size_t>(vertex_count, 1))
+              << ", "sv << static_cast<double>(label_bytes) / 1e6 << " MB (all pairs table "sv
+              << static_cast<double>(vertex_count * vertex_count * (sizeof(double) + sizeof(uint32_t))) / 1e6
+              << " MB)\n"sv;
+    std::cout << "  mismatches: "sv << CountMismatches(hierarchy_times, labels_times) << '\n';
+}
+
+// сравнивает RAPTOR с поиском Дейкстры по графу: построение, размер данных и запросы
+void BenchmarkRaptor(const transport_catalogue::TransportCatalogue& catalogue,
+                     TransportRouter::RoutingSettings settings) {
+    const auto queries = MakeQueries(catalogue);
+    std::cout << "RAPTOR vs graph Dijkstra, queries: "sv << queries.size() << '\n';
+    if (queries.empty()) {
+        return;
+    }
+
+    settings.engine = TransportRouter::Engine::DIJKSTRA;
+    TransportRouter dijkstra(catalogue, settings);
+    const double dijkstra_build_time = MeasureSeconds([&] {
+        dijkstra.InitRouter();
+    });
+    settings.engine = TransportRouter::Engine::RAPTOR;
+    TransportRouter raptor(catalogue, settings);
+    const double raptor_build_time = MeasureSeconds([&] {
+        raptor.InitRouter();
+    });
+
+    std::vector<double> dijkstra_times;
+    const double dijkstra_time = RunQueries(dijkstra, queries, dijkstra_times);
+    std::vector<double> raptor_times;
+    const double raptor_time = RunQueries(raptor, queries, raptor_times);
+
+    std::cout << "  graph:  build "sv << dijkstra_build_time << " s, edges "sv
+              << dijkstra.GetGraph().GetEdgeCount() << ", queries "sv << dijkstra_time << " s\n"sv;
+    std::cout << "  raptor: build "sv << raptor_build_time << " s, patterns "sv
+              << raptor.GetRaptorRouter()->GetPatternCount() << ", queries "sv << raptor_time << " s\n"sv;
+    std::cout << "  mismatches: "sv << CountMismatches(dijkstra_times, raptor_times) << '\n';
+}
+
+// запросы из нескольких потоков к одному построенному маршрутизатору против одного потока
+void BenchmarkConcurrentQueries(const transport_catalogue::TransportCatalogue& catalogue,
+                                TransportRouter::RoutingSettings settings) {
+    // потоков не меньше четырёх, чтобы одновременные запросы проверялись и на малом числе ядер
+    concurrency::ThreadPool pool(std::max(4u, std::thread::hardware_concurrency()));
+    const auto queries = MakeQueries(catalogue);
+    std::cout << "Concurrent queries, threads: "sv << pool.GetThreadCount() << ", queries: "sv
+              << queries.size() << '\n';
+    if (queries.empty()) {
+        return;
+    }
+
+    const std::pair<TransportRouter::Engine, std::string_view> engines[] = {
+        {TransportRouter::Engine::DIJKSTRA, "dijkstra"sv},
+        {TransportRouter::Engine::CONTRACTION_HIERARCHY, "contraction_hierarchy"sv},
+        {TransportRouter::Engine::RAPTOR, "raptor"sv},
+    };
+    for (const auto& [engine, engine_name] : engines) {
+        settings.engine = engine;
+        settings.route_cache_size = 0;
+        TransportRouter router(catalogue, settings);
+        router.InitRouter();
+        const TransportRouter& built_router = router;
+
+        std::vector<double> single_times;
+        const double single_time = RunQueries(router, queries, single_times);
+        std::vector<double> concurrent_times(queries.size());
+        const double concurrent_time = MeasureSeconds([&] {
+            pool.ParallelFor(queries.size(), [&](size_t i) {
+                concurrent_times[i] = GetRouteTime(built_router.BuildRoute(queries[i].first, queries[i].second));
+            });
+        });
+
+        std::cout << "  "sv << engine_name << ": 1 thread "sv << single_time << " s, "sv
+                  << pool.GetThreadCount() << " threads "sv << concurrent_time << " s, mismatches "sv
+                  << CountMismatches(single_times, concurrent_times) << '\n';
+    }
+}
+
+// повторяющиеся запросы с кэшем ответов и без него
+void BenchmarkRouteCache(const transport_catalogue::TransportCatalogue& catalogue,
+                         TransportRouter::RoutingSettings settings) {
+    constexpr size_t HOT_QUERY_COUNT = 50;
+    auto queries = MakeQueries(catalogue);
+    if (queries.size() < HOT_QUERY_COUNT) {
+        return;
+    }
+    // небольшое число популярных пар составляет весь поток запросов
+    for (size_t i = HOT_QUERY_COUNT; i < queries.size(); ++i) {
+        queries[i] = queries[i % HOT_QUERY_COUNT];
+    }
+    std::cout << "Route cache, queries: "sv << queries.size() << ", distinct: "sv << HOT_QUERY_COUNT << '\n';
+
+    settings.engine = TransportRouter::Engine::DIJKSTRA;
+    settings.route_cache_size = 0;
+    TransportRouter uncached(catalogue, settings);
+    uncached.InitRouter();
+    settings.route_cache_size = 2 * HOT_QUERY_COUNT;
+    TransportRouter cached(catalogue, settings);
+    cached.InitRouter();
+
+    std::vector<double> uncached_times;
+    const double uncached_time = RunQueries(uncached, queries, uncached_times);
+    std::vector<double> cached_times;
+    const double cached_time = RunQueries(cached, queries, cached_times);
+
+    const auto* cache = cached.GetRouteCache();
+    std::cout << "  without cache: "sv << uncached_time << " s\n"sv;
+    std::cout << "  with cache:    "sv << cached_time << " s, hits "sv << cache->GetHitCount()
+              << ", misses "sv << cache->GetMissCount() << '\n';
+    std::cout << "  mismatches: "sv << CountMismatches(uncached_times, cached_times) << '\n';
+}
+
+// матрица времени в пути против отдельных запросов маршрута для каждой пары
+void BenchmarkTravelTimeMatrix(const transport_catalogue::TransportCatalogue& catalogue,
+                               TransportRouter::RoutingSettings settings) {
+    constexpr size_t ORIGIN_COUNT = 20;
+    std::vector<std::string> destinations;
+    for (const auto& [name, stop] : catalogue.GetStops()) {
+        destinations.emplace_back(name);
+    }
+    std::vector<std::string> origins(destinations.begin(),
+                                     destinations.begin() + static_cast<std::ptrdiff_t>(
+                                             std::min(ORIGIN_COUNT, destinations.size())));
+    std::cout << "Travel time matrix "sv << origins.size() << " x "sv << destinations.size() << '\n';
+
+    settings.engine = TransportRouter::Engine::DIJKSTRA;
+    TransportRouter router(catalogue, settings);
+    router.InitRouter();
+
+    std::vector<double> matrix_times;
+    const double matrix_time = MeasureSeconds([&] {
+        router.BuildTravelTimeMatrix(origins, destinations,
+                                     [&](size_t, const TransportRouter::TravelTimes& times) {
+            for (const auto& time : times) {
+                matrix_times.push_back(time.value_or(-1));
+            }
+        });
+    });
+    std::vector<double> route_times;
+    const double route_time = MeasureSeconds([&] {
+        for (const auto& from : origins) {
+            for (const auto& to : destinations) {
+                route_times.push_back(GetRouteTime(router.BuildRoute(from, to)));
+            }
+        }
+    });
+
+    std::cout << "  matrix: "sv << matrix_time << " s\n"sv;
+    std::cout << "  routes: "sv << route_time << " s\n"sv;
+    std::cout << "  mismatches: "sv << CountMismatches(route_times, matrix_times) << '\n';
+}
+
+// ленивые строки таблицы маршрутов против полной таблицы: запуск и запросы
+void BenchmarkLazyRows(const transport_catalogue::TransportCatalogue& catalogue,
+                       TransportRouter::RoutingSettings settings) {
+    const auto queries = MakeQueries(catalogue);
+    std::cout << "Lazy rows vs all pairs, queries: "sv << queries.size() << '\n';
+    if (queries.empty()) {
+        return;
+    }
+
+    settings.engine = TransportRouter::Engine::ALL_PAIRS;
+    TransportRouter all_pairs(catalogue, settings);
+    const double all_pairs_build_time = MeasureSeconds([&] {
+        all_pairs.InitRouter();
+    });
+    settings.engine = TransportRouter::Engine::LAZY_ROWS;
+    TransportRouter lazy(catalogue, settings);
+    const double lazy_build_time = MeasureSeconds([&] {
+        lazy.InitRouter();
+    });
+
+    std::vector<double> all_pairs_times;
+    const double all_pairs_time = RunQueries(all_pairs, queries, all_pairs_times);
+    std::vector<double> lazy_times;
+    const double lazy_time = RunQueries(lazy, queries, lazy_times);
+
+    const auto& lazy_router = lazy.GetLazyRouter();
+    std::cout << "  all pairs: build "sv << all_pairs_build_time << " s, queries "sv << all_pairs_time << " s\n"sv;
+    std::cout << "  lazy rows: build "sv << lazy_build_time << " s, queries "sv << lazy_time
+              << " s, rows computed "sv << lazy_router->GetComputedRowCount()
+              << ", kept "sv << lazy_router->GetRowCount() << '/' << lazy_router->GetMaxRowCount() << '\n';
+    std::cout << "  mismatches: "sv << CountMismatches(all_pairs_times, lazy_times) << '\n';
+}
+
+// время поиска альтернативных маршрутов в зависимости от их числа
+void BenchmarkAlternatives(const transport_catalogue::TransportCatalogue& catalogue,
+                           TransportRouter::RoutingSettings settings) {
+    constexpr size_t ALTERNATIVES_QUERY_COUNT = 100;
+    auto queries = MakeQueries(catalogue);
+    queries.resize(std::min(queries.size(), ALTERNATIVES_QUERY_COUNT));
+    std::cout << "Alternative routes (Yen), queries: "sv << queries.size() << '\n';
+    if (queries.empty()) {
+        return;
+    }
+
+    settings.engine = TransportRouter::Engine::DIJKSTRA;
+    TransportRouter router(catalogue, settings);
+    router.InitRouter();
+    for (const size_t route_count : {1, 2, 3, 5, 8}) {
+        size_t found_count = 0;
+        const double time = MeasureSeconds([&] {
+            for (const auto& [from, to] : queries) {
+                found_count += router.BuildRoutes(from, to, route_count).size();
+            }
+        });
+        std::cout << "  k = "sv << route_count << ": "sv << time << " s, routes per query "sv
+                  << static_cast<double>(found_count) / static_cast<double>(queries.size()) << '\n';
+    }
+}
+
+// релаксация строки таблицы маршрутов каждым из поддерживаемых наборов инструкций
+void BenchmarkMinPlus() {
+    namespace min_plus = graph::min_plus;
+    constexpr size_t ROW_SIZE = 4096;
+    constexpr size_t REPEAT_COUNT = 20000;
+    constexpr uint32_t NO_EDGE = Router::RoutesInternalData::NO_EDGE;
+
+    // строка через опорную вершину и текущая строка: часть ячеек недостижима,
+    // примерно четверть ячеек улучшается
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> weight_distribution(0.0, 100.0);
+    std::uniform_int_distribution<uint32_t> edge_distribution(0, 1000000);
+    std::vector<double> through_weights(ROW_SIZE);
+    std::vector<uint32_t> through_prev_edges(ROW_SIZE);
+    std::vector<double> initial_weights(ROW_SIZE);
+    std::vector<uint32_t> initial_prev_edges(ROW_SIZE);
+    for (size_t i = 0; i < ROW_SIZE; ++i) {
+        through_weights[i] = i % 16 == 0 ? Router::RoutesInternalData::UNREACHABLE : weight_distribution(generator);
+        through_prev_edges[i] = i % 32 == 1 ? NO_EDGE : edge_distribution(generator);
+        initial_weights[i] = i % 8 == 0 ? Router::RoutesInternalData::UNREACHABLE
+                                        : 20.0 + weight_distribution(generator);
+        initial_prev_edges[i] = edge_distribution(generator);
+    }
+    const double from_weight = 10.0;
+    const uint32_t from_prev_edge = 42;
+
+    std::cout << "Min-plus row relaxation, row "sv << ROW_SIZE << ", repeats "sv << REPEAT_COUNT
+              << ", dispatched: "sv << min_plus::GetIsaName(min_plus::GetIsa()) << '\n';
+    std::vector<double> scalar_weights;
+    std::vector<uint32_t> scalar_prev_edges;
+    for (const auto isa : {min_plus::Isa::SCALAR, min_plus::Isa::AVX2, min_plus::Isa::AVX512}) {
+        if (!min_plus::IsSupported(isa)) {
+            std::cout << "  "sv << min_plus::GetIsaName(isa) << ": not supported\n"sv;
+            continue;
+        }
+        std::vector<double> weights;
+        std::vector<uint32_t> prev_edges;
+        // восстановление строки перед каждым повтором в замер не входит
+        double time = 0;
+        for (size_t repeat = 0; repeat < REPEAT_COUNT; ++repeat) {
+            weights = initial_weights;
+            prev_edges = initial_prev_edges;
+            time += MeasureSeconds([&] {
+                min_plus::RelaxRow(isa, from_weight, from_prev_edge, through_weights.data(), through_prev_edges.data(),
+                                   weights.data(), prev_edges.data(), ROW_SIZE, NO_EDGE);
+            });
+        }
+        if (isa == min_plus::Isa::SCALAR) {
+            scalar_weights = weights;
+            scalar_prev_edges = prev_edges;
+        }
+        const bool is_identical =
+                std::memcmp(weights.data(), scalar_weights.data(), ROW_SIZE * sizeof(double)) == 0
+                && prev_edges == scalar_prev_edges;
+        std::cout << "  "sv << min_plus::GetIsaName(isa) << ": "sv << time << " s, "sv
+                  << static_cast<double>(ROW_SIZE * REPEAT_COUNT) / time / 1e9 << " Gcells/s, identical: "sv
+                  << (is_identical ? "yes"sv : "NO"sv) << '\n';
+    }
+}
+
+// Добавляет в каталог несколько автобусов между случайными остановками (недостающие
+// расстояния - по прямой с запасом) и сравнивает дополнение таблицы всех пар
+// через рёбра новых автобусов с её полной перестройкой
+void BenchmarkIncrementalUpdate(transport_catalogue::TransportCatalogue& catalogue,
+                                TransportRouter::RoutingSettings settings) {
+    constexpr size_t PATCH_BUS_COUNT = 5;
+    constexpr size_t PATCH_BUS_STOP_COUNT = 6;
+
+    std::vector<std::string> stop_names;
+    for (const auto& [name, stop] : catalogue.GetStops()) {
+        stop_names.emplace_back(name);
+    }
+    std::cout << "Incremental update, new buses: "sv << PATCH_BUS_COUNT << '\n';
+    if (stop_names.size() < 2) {
+        return;
+    }
+
+    settings.engine = TransportRouter::Engine::ALL_PAIRS;
+    TransportRouter incremental(catalogue, settings);
+    incremental.InitRouter();
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<size_t> distribution(0, stop_names.size() - 1);
+    std::vector<std::string> bus_names;
+    for (size_t bus = 0; bus < PATCH_BUS_COUNT; ++bus) {
+        std::vector<std::string> stops{stop_names[distribution(generator)]};
+        while (stops.size() < PATCH_BUS_STOP_COUNT) {
+            const std::string& stop = stop_names[distribution(generator)];
+            if (stop == stops.back()) {
+                continue;
+            }
+            try {
+                catalogue.GetDistance(stops.back(), stop);
+            } catch (const std::out_of_range&) {
+                const double distance = geo::ComputeDistance(catalogue.GetStops().at(stops.back())->coordinate,
+                                                             catalogue.GetStops().at(stop)->coordinate);
+                catalogue.SetDistanceStops(stops.back(), stop, static_cast<int>(std::ceil(distance * 1.1)) + 1);
+            }
+            stops.push_back(stop);
+        }
+        bus_names.push_back("patch "s + std::to_string(bus));
+        catalogue.AddBus(bus_names.back(), domain::RouteType::LINEAR, stops);
+    }
+
+    const double update_time = MeasureSeconds([&] {
+        for (const auto& bus_name : bus_names) {
+            incremental.AddBus(bus_name);
+        }
+    });
+    TransportRouter rebuilt(catalogue, settings);
+    const double rebuild_time = MeasureSeconds([&] {
+        rebuilt.InitRouter();
+    });
+
+    // номера рёбер у перестроенного графа другие, поэтому сравниваются только веса
+    const auto& expected = rebuilt.GetRouter()->GetRoutesInternalData().GetWeights();
+    const auto& actual = incremental.GetRouter()->GetRoutesInternalData().GetWeights();
+    std::vector<double> expected_times(expected.begin(), expected.end());
+    std::vector<double> actual_times(actual.begin(), actual.end());
+    for (auto* times : {&expected_times, &actual_times}) {
+        std::replace(times->begin(), times->end(), Router::RoutesInternalData::UNREACHABLE, -1.0);
+    }
+
+    std::cout << "  incremental: "sv << update_time << " s\n"sv;
+    std::cout << "  rebuild:     "sv << rebuild_time << " s\n"sv;
+    std::cout << "  mismatches:  "sv << CountMismatches(expected_times, actual_times)
+              << " of "sv << expected_times.size() << '\n';
+}
+
+} // namespace
+
+int main() {
+    transport_catalogue::TransportCatalogue catalogue;
+    json_reader::JsonLoader json(std::cin);
+    json.LoadData(catalogue);
+    auto routing_settings = json.LoadRoutingSettings();
+    if (!routing_settings) {
+        std::cerr << "Can't find routing settings"sv << std::endl;
+        return 1;
+    }
+
+    // граф строится без таблицы маршрутов: её построение и замеряется
+    routing_settings->engine = transport_router::TransportRouter::Engine::DIJKSTRA;
+    transport_router::TransportRouter router(catalogue, *routing_settings);
+    router.InitRouter();
+
+    BenchmarkMinPlus();
+    BenchmarkRouteDistances(catalogue);
+    BenchmarkBuildEdges(catalogue, *routing_settings);
+    BenchmarkGraphLayout(router.GetGraph());
+    BenchmarkGraphIdWidth(router.GetGraph());
+    BenchmarkStopOrder(router.GetGraph(), router.GetStopsById().size());
+    BenchmarkFloydWarshall(router.GetGraph());
+    BenchmarkPathReconstruction(router.GetGraph());
+    BenchmarkGraphModels(catalogue, *routing_settings);
+    BenchmarkChainCompression(catalogue, *routing_settings);
+    BenchmarkAStar(catalogue, *routing_settings);
+    BenchmarkHubLabels(catalogue, *routing_settings);
+    BenchmarkRaptor(catalogue, *routing_settings);
+    BenchmarkConcurrentQueries(catalogue, *routing_settings);
+    BenchmarkRouteCache(catalogue, *routing_settings);
+    BenchmarkTravelTimeMatrix(catalogue, *routing_settings);
+    BenchmarkLazyRows(catalogue, *routing_settings);
+    BenchmarkAlternatives(catalogue, *routing_settings);
+    // меняет каталог, поэтому выполняется последним
+    BenchmarkIncrementalUpdate(catalogue, *routing_settings);
+}
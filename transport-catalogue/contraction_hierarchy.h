@@ -0,0 +1,593 @@
+#pragma once
+
+#include "graph.h"
+#include "router.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// Иерархия сжатия (Contraction Hierarchies).
+// При построении вершины по очереди "сжимаются" в порядке важности, а пути через
+// сжатую вершину заменяются рёбрами-сокращениями (shortcut). Запрос - двунаправленный
+// поиск Дейкстры только по рёбрам, ведущим к более важным вершинам,
+// после чего сокращения разворачиваются в исходные рёбра графа.
+// Рёбра иерархии нумеруются так: [0, EdgeCount) - рёбра исходного графа,
+// далее - сокращения в порядке их добавления.
+// Построенная иерархия не меняется: запросы с разными Scratch можно выполнять
+// из нескольких потоков одновременно.
+template <typename Weight>
+class ContractionHierarchy {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+    struct QueueItem {
+        Weight weight;
+        VertexId vertex;
+    };
+
+    // состояние поиска в одном направлении: вершина достигнута,
+    // если её метка совпадает с номером текущего поиска
+    struct SearchState {
+        std::vector<Weight> weights;
+        std::vector<EdgeId> prev_edges;
+        std::vector<uint32_t> marks;
+        uint32_t mark = 0;
+        std::vector<QueueItem> queue;
+    };
+
+public:
+    using RouteInfo = typename Router<Weight>::RouteInfo;
+
+    // рабочие буферы запроса одного потока; размеры подстраиваются под граф при первом запросе
+    struct Scratch {
+        SearchState forward;
+        SearchState backward;
+        std::vector<EdgeId> unpack_stack;
+    };
+
+    struct Shortcut {
+        VertexId from;
+        VertexId to;
+        Weight weight;
+        // рёбра иерархии, из которых составлено сокращение
+        EdgeId first;
+        EdgeId second;
+    };
+
+    // строит иерархию по графу
+    explicit ContractionHierarchy(const Graph& graph);
+    // восстанавливает ранее построенную иерархию (например, при десериализации)
+    ContractionHierarchy(const Graph& graph, std::vector<size_t> ranks, std::vector<Shortcut> shortcuts);
+
+    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to, Scratch& scratch) const;
+    // маршрут в память вызывающего: edges очищается и заполняется рёбрами от первого к последнему
+    std::optional<Weight> BuildRoute(VertexId from, VertexId to, Scratch& scratch, std::vector<EdgeId>& edges) const;
+
+    // доступ к внутренним данным
+    const std::vector<size_t>& GetRanks() const;
+    const std::vector<Shortcut>& GetShortcuts() const;
+
+private:
+    // ребро иерархии в списке смежности вершины
+    struct HierarchyEdge {
+        VertexId vertex;
+        EdgeId edge;
+        Weight weight;
+    };
+
+    class Builder;
+
+    void Contract();
+    void BuildSearchGraph();
+
+    static void Reach(SearchState& state, VertexId vertex, const Weight& weight, EdgeId prev_edge);
+    static bool IsReached(const SearchState& state, VertexId vertex);
+    void StartSearch(Scratch& scratch) const;
+    // выполняет шаг поиска в одном направлении, обновляя лучшую точку встречи
+    void SearchStep(SearchState& state, const SearchState& opposite_state,
+                    const std::vector<size_t>& offsets, const std::vector<HierarchyEdge>& edges,
+                    std::optional<Weight>& best_weight, VertexId& meeting_vertex) const;
+
+    VertexId GetEdgeFrom(EdgeId edge_id) const;
+    VertexId GetEdgeTo(EdgeId edge_id) const;
+    // разворачивает ребро иерархии в рёбра исходного графа
+    void UnpackEdge(EdgeId edge_id, std::vector<EdgeId>& unpack_stack, std::vector<EdgeId>& result) const;
+
+    static bool QueueCompare(const QueueItem& lhs, const QueueItem& rhs) {
+        return lhs.weight > rhs.weight;
+    }
+
+    static constexpr Weight ZERO_WEIGHT{};
+    static constexpr EdgeId NO_EDGE = std::numeric_limits<EdgeId>::max();
+
+    const Graph& graph_;
+    std::vector<size_t> ranks_;
+    std::vector<Shortcut> shortcuts_;
+
+    // рёбра к более важным вершинам: исходящие для прямого поиска
+    // и входящие для обратного, в виде смещений и общего массива
+    std::vector<size_t> up_offsets_;
+    std::vector<HierarchyEdge> up_edges_;
+    std::vector<size_t> down_offsets_;
+    std::vector<HierarchyEdge> down_edges_;
+};
+
+// Построитель иерархии: поддерживает рабочий граф без сжатых вершин
+// и выполняет локальные поиски свидетелей (witness search)
+template <typename Weight>
+class ContractionHierarchy<Weight>::Builder {
+public:
+    Builder(const Graph& graph, std::vector<size_t>& ranks, std::vector<Shortcut>& shortcuts)
+        : graph_(graph)
+        , ranks_(ranks)
+        , shortcuts_(shortcuts)
+        , out_(graph.GetVertexCount())
+        , in_(graph.GetVertexCount())
+        , contracted_(graph.GetVertexCount(), false)
+        , contracted_neighbors_(graph.GetVertexCount(), 0)
+        , witness_weights_(graph.GetVertexCount())
+        , witness_marks_(graph.GetVertexCount(), 0) {
+        for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+            const auto& edge = graph.GetEdge(edge_id);
+            if (edge.weight < ZERO_WEIGHT) {
+                throw std::domain_error("Edges' weights should be non-negative");
+            }
+            if (edge.from != edge.to) {
+                AddEdge(edge.from, edge.to, edge.weight, edge_id);
+            }
+        }
+    }
+
+    void Build() {
+        const size_t vertex_count = graph_.GetVertexCount();
+        ranks_.assign(vertex_count, 0);
+
+        std::vector<std::pair<int64_t, VertexId>> queue;
+        queue.reserve(vertex_count);
+        for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+            queue.push_back({GetPriority(vertex), vertex});
+        }
+        std::make_heap(queue.begin(), queue.end(), std::greater<>{});
+
+        // ленивое обновление приоритетов: приоритет извлечённой вершины
+        // пересчитывается, и если она перестала быть минимальной - возвращается в очередь
+        size_t rank = 0;
+        while (!queue.empty()) {
+            std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+            const VertexId vertex = queue.back().second;
+            queue.pop_back();
+
+            const int64_t priority = GetPriority(vertex);
+            if (!queue.empty() && priority > queue.front().first) {
+                queue.push_back({priority, vertex});
+                std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+                continue;
+            }
+            ContractVertex(vertex, false);
+            ranks_[vertex] = rank++;
+        }
+    }
+
+private:
+    struct WorkingEdge {
+        VertexId vertex;
+        Weight weight;
+        EdgeId edge;
+    };
+
+    // число вершин, извлекаемых поиском свидетеля, после которого путь считается не найденным;
+    // при оценке приоритета достаточно более грубого поиска
+    static constexpr size_t WITNESS_SETTLED_LIMIT = 500;
+    static constexpr size_t SIMULATION_SETTLED_LIMIT = 150;
+
+    // добавляет ребро в рабочий граф, из параллельных рёбер оставляет самое лёгкое
+    void AddEdge(VertexId from, VertexId to, const Weight& weight, EdgeId edge_id) {
+        auto out_it = std::find_if(out_[from].begin(), out_[from].end(),
+                                   [to](const WorkingEdge& edge) { return edge.vertex == to; });
+        if (out_it == out_[from].end()) {
+            out_[from].push_back({to, weight, edge_id});
+            in_[to].push_back({from, weight, edge_id});
+            return;
+        }
+        if (weight < out_it->weight) {
+            *out_it = {to, weight, edge_id};
+            auto in_it = std::find_if(in_[to].begin(), in_[to].end(),
+                                      [from](const WorkingEdge& edge) { return edge.vertex == from; });
+            *in_it = {from, weight, edge_id};
+        }
+    }
+
+    int64_t GetPriority(VertexId vertex) {
+        const auto shortcuts_count = static_cast<int64_t>(ContractVertex(vertex, true));
+        const auto edges_count = static_cast<int64_t>(out_[vertex].size() + in_[vertex].size());
+        return shortcuts_count - edges_count + static_cast<int64_t>(contracted_neighbors_[vertex]);
+    }
+
+    // сжимает вершину (или только подсчитывает нужные сокращения, если simulate)
+    // возвращает количество сокращений
+    size_t ContractVertex(VertexId vertex, bool simulate) {
+        size_t shortcuts_count = 0;
+        for (size_t in_index = 0; in_index < in_[vertex].size(); ++in_index) {
+            // копия: при добавлении сокращений списки смежности могут измениться
+            const WorkingEdge in_edge = in_[vertex][in_index];
+
+            bool has_targets = false;
+            Weight max_weight = ZERO_WEIGHT;
+            for (const auto& out_edge : out_[vertex]) {
+                if (out_edge.vertex == in_edge.vertex) {
+                    continue;
+                }
+                const Weight candidate_weight = in_edge.weight + out_edge.weight;
+                if (!has_targets || max_weight < candidate_weight) {
+                    max_weight = candidate_weight;
+                }
+                has_targets = true;
+            }
+            if (!has_targets) {
+                continue;
+            }
+
+            FindWitnesses(in_edge.vertex, vertex, max_weight,
+                          simulate ? SIMULATION_SETTLED_LIMIT : WITNESS_SETTLED_LIMIT);
+            for (size_t out_index = 0; out_index < out_[vertex].size(); ++out_index) {
+                const WorkingEdge out_edge = out_[vertex][out_index];
+                if (out_edge.vertex == in_edge.vertex) {
+                    continue;
+                }
+                const Weight candidate_weight = in_edge.weight + out_edge.weight;
+                if (IsWitnessReached(out_edge.vertex)
+                    && !(candidate_weight < witness_weights_[out_edge.vertex])) {
+                    continue;
+                }
+                ++shortcuts_count;
+                if (!simulate) {
+                    const EdgeId shortcut_id = graph_.GetEdgeCount() + shortcuts_.size();
+                    shortcuts_.push_back({in_edge.vertex, out_edge.vertex, candidate_weight,
+                                          in_edge.edge, out_edge.edge});
+                    AddEdge(in_edge.vertex, out_edge.vertex, candidate_weight, shortcut_id);
+                }
+            }
+        }
+
+        if (!simulate) {
+            RemoveVertex(vertex);
+        }
+        return shortcuts_count;
+    }
+
+    // удаляет сжатую вершину из списков смежности соседей
+    void RemoveVertex(VertexId vertex) {
+        const auto is_vertex = [vertex](const WorkingEdge& edge) { return edge.vertex == vertex; };
+        for (const auto& edge : out_[vertex]) {
+            auto& list = in_[edge.vertex];
+            list.erase(std::remove_if(list.begin(), list.end(), is_vertex), list.end());
+            ++contracted_neighbors_[edge.vertex];
+        }
+        for (const auto& edge : in_[vertex]) {
+            auto& list = out_[edge.vertex];
+            list.erase(std::remove_if(list.begin(), list.end(), is_vertex), list.end());
+            ++contracted_neighbors_[edge.vertex];
+        }
+        out_[vertex].clear();
+        out_[vertex].shrink_to_fit();
+        in_[vertex].clear();
+        in_[vertex].shrink_to_fit();
+        contracted_[vertex] = true;
+    }
+
+    // поиск Дейкстры из source в рабочем графе в обход вершины excluded,
+    // ограниченный весом max_weight и числом извлечённых вершин settled_limit
+    void FindWitnesses(VertexId source, VertexId excluded, const Weight& max_weight, size_t settled_limit) {
+        if (++witness_mark_ == 0) {
+            std::fill(witness_marks_.begin(), witness_marks_.end(), 0);
+            witness_mark_ = 1;
+        }
+        witness_queue_.clear();
+        ReachWitness(source, ZERO_WEIGHT);
+        witness_queue_.push_back({ZERO_WEIGHT, source});
+
+        size_t settled_count = 0;
+        while (!witness_queue_.empty() && settled_count < settled_limit) {
+            std::pop_heap(witness_queue_.begin(), witness_queue_.end(), QueueCompare);
+            const QueueItem item = witness_queue_.back();
+            witness_queue_.pop_back();
+
+            if (witness_weights_[item.vertex] < item.weight) {
+                continue;
+            }
+            if (max_weight < item.weight) {
+                break;
+            }
+            ++settled_count;
+            for (const auto& edge : out_[item.vertex]) {
+                if (edge.vertex == excluded) {
+                    continue;
+                }
+                const Weight candidate_weight = item.weight + edge.weight;
+                if (!IsWitnessReached(edge.vertex) || candidate_weight < witness_weights_[edge.vertex]) {
+                    ReachWitness(edge.vertex, candidate_weight);
+                    witness_queue_.push_back({candidate_weight, edge.vertex});
+                    std::push_heap(witness_queue_.begin(), witness_queue_.end(), QueueCompare);
+                }
+            }
+        }
+    }
+
+    void ReachWitness(VertexId vertex, const Weight& weight) {
+        witness_weights_[vertex] = weight;
+        witness_marks_[vertex] = witness_mark_;
+    }
+
+    bool IsWitnessReached(VertexId vertex) const {
+        return witness_marks_[vertex] == witness_mark_;
+    }
+
+    const Graph& graph_;
+    std::vector<size_t>& ranks_;
+    std::vector<Shortcut>& shortcuts_;
+
+    std::vector<std::vector<WorkingEdge>> out_;
+    std::vector<std::vector<WorkingEdge>> in_;
+    std::vector<bool> contracted_;
+    std::vector<size_t> contracted_neighbors_;
+
+    std::vector<Weight> witness_weights_;
+    std::vector<uint32_t> witness_marks_;
+    uint32_t witness_mark_ = 0;
+    std::vector<QueueItem> witness_queue_;
+};
+
+template <typename Weight>
+ContractionHierarchy<Weight>::ContractionHierarchy(const Graph& graph)
+    : graph_(graph)
+{
+    Contract();
+    BuildSearchGraph();
+}
+
+template <typename Weight>
+ContractionHierarchy<Weight>::ContractionHierarchy(const Graph& graph, std::vector<size_t> ranks,
+                                                   std::vector<Shortcut> shortcuts)
+    : graph_(graph)
+    , ranks_(std::move(ranks))
+    , shortcuts_(std::move(shortcuts))
+{
+    if (ranks_.size() != graph.GetVertexCount()) {
+        throw std::invalid_argument("Ranks count must be equal to vertex count");
+    }
+    BuildSearchGraph();
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::Contract() {
+    Builder builder(graph_, ranks_, shortcuts_);
+    builder.Build();
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::BuildSearchGraph() {
+    const size_t vertex_count = graph_.GetVertexCount();
+    const EdgeId edge_count = graph_.GetEdgeCount() + shortcuts_.size();
+
+    // подсчёт рёбер, затем раскладка по смещениям
+    up_offsets_.assign(vertex_count + 1, 0);
+    down_offsets_.assign(vertex_count + 1, 0);
+    for (EdgeId edge_id = 0; edge_id < edge_count; ++edge_id) {
+        const VertexId from = GetEdgeFrom(edge_id);
+        const VertexId to = GetEdgeTo(edge_id);
+        if (ranks_[from] < ranks_[to]) {
+            ++up_offsets_[from + 1];
+        } else if (ranks_[to] < ranks_[from]) {
+            ++down_offsets_[to + 1];
+        }
+    }
+    for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+        up_offsets_[vertex + 1] += up_offsets_[vertex];
+        down_offsets_[vertex + 1] += down_offsets_[vertex];
+    }
+
+    up_edges_.resize(up_offsets_.back());
+    down_edges_.resize(down_offsets_.back());
+    std::vector<size_t> up_positions(up_offsets_.begin(), up_offsets_.end() - 1);
+    std::vector<size_t> down_positions(down_offsets_.begin(), down_offsets_.end() - 1);
+    for (EdgeId edge_id = 0; edge_id < edge_count; ++edge_id) {
+        const VertexId from = GetEdgeFrom(edge_id);
+        const VertexId to = GetEdgeTo(edge_id);
+        const Weight& weight = edge_id < graph_.GetEdgeCount()
+                ? graph_.GetEdge(edge_id).weight
+                : shortcuts_[edge_id - graph_.GetEdgeCount()].weight;
+        if (ranks_[from] < ranks_[to]) {
+            up_edges_[up_positions[from]++] = {to, edge_id, weight};
+        } else if (ranks_[to] < ranks_[from]) {
+            down_edges_[down_positions[to]++] = {from, edge_id, weight};
+        }
+    }
+}
+
+template <typename Weight>
+std::optional<typename ContractionHierarchy<Weight>::RouteInfo>
+ContractionHierarchy<Weight>::BuildRoute(VertexId from, VertexId to, Scratch& scratch) const {
+    std::vector<EdgeId> edges;
+    auto weight = BuildRoute(from, to, scratch, edges);
+    if (!weight) {
+        return std::nullopt;
+    }
+    return RouteInfo{*weight, std::move(edges)};
+}
+
+template <typename Weight>
+std::optional<Weight> ContractionHierarchy<Weight>::BuildRoute(VertexId from, VertexId to, Scratch& scratch,
+                                                               std::vector<EdgeId>& edges) const {
+    if (from >= graph_.GetVertexCount() || to >= graph_.GetVertexCount()) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+
+    StartSearch(scratch);
+    SearchState& forward = scratch.forward;
+    SearchState& backward = scratch.backward;
+    std::vector<EdgeId>& unpack_stack = scratch.unpack_stack;
+    edges.clear();
+    Reach(forward, from, ZERO_WEIGHT, NO_EDGE);
+    forward.queue.push_back({ZERO_WEIGHT, from});
+    Reach(backward, to, ZERO_WEIGHT, NO_EDGE);
+    backward.queue.push_back({ZERO_WEIGHT, to});
+
+    std::optional<Weight> best_weight;
+    VertexId meeting_vertex = from;
+    if (from == to) {
+        best_weight = ZERO_WEIGHT;
+    }
+
+    // на каждом шаге продвигаем направление с меньшим весом в голове очереди;
+    // поиск завершается, когда обе очереди не могут улучшить найденный путь
+    while (!forward.queue.empty() || !backward.queue.empty()) {
+        const bool forwardstep = backward.queue.empty()
+                || (!forward.queue.empty()
+                    && !(backward.queue.front().weight < forward.queue.front().weight));
+        const auto& front = forwardstep ? forward.queue.front() : backward.queue.front();
+        if (best_weight && !(front.weight < *best_weight)) {
+            break;
+        }
+        if (forwardstep) {
+            SearchStep(forward, backward, up_offsets_, up_edges_, best_weight, meeting_vertex);
+        } else {
+            SearchStep(backward, forward, down_offsets_, down_edges_, best_weight, meeting_vertex);
+        }
+    }
+
+    if (!best_weight) {
+        return std::nullopt;
+    }
+
+    // путь от начала до точки встречи собирается с конца
+    for (EdgeId edge_id = forward.prev_edges[meeting_vertex]; edge_id != NO_EDGE;
+         edge_id = forward.prev_edges[GetEdgeFrom(edge_id)]) {
+        unpack_stack.push_back(edge_id);
+    }
+    while (!unpack_stack.empty()) {
+        const EdgeId edge_id = unpack_stack.back();
+        unpack_stack.pop_back();
+        UnpackEdge(edge_id, unpack_stack, edges);
+    }
+    for (EdgeId edge_id = backward.prev_edges[meeting_vertex]; edge_id != NO_EDGE;
+         edge_id = backward.prev_edges[GetEdgeTo(edge_id)]) {
+        UnpackEdge(edge_id, unpack_stack, edges);
+    }
+
+    return best_weight;
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::SearchStep(SearchState& state, const SearchState& opposite_state,
+                                              const std::vector<size_t>& offsets,
+                                              const std::vector<HierarchyEdge>& edges,
+                                              std::optional<Weight>& best_weight,
+                                              VertexId& meeting_vertex) const {
+    std::pop_heap(state.queue.begin(), state.queue.end(), QueueCompare);
+    const QueueItem item = state.queue.back();
+    state.queue.pop_back();
+
+    if (state.weights[item.vertex] < item.weight) {
+        return;
+    }
+    if (IsReached(opposite_state, item.vertex)) {
+        const Weight route_weight = item.weight + opposite_state.weights[item.vertex];
+        if (!best_weight || route_weight < *best_weight) {
+            best_weight = route_weight;
+            meeting_vertex = item.vertex;
+        }
+    }
+    for (size_t index = offsets[item.vertex]; index < offsets[item.vertex + 1]; ++index) {
+        const auto& edge = edges[index];
+        const Weight candidate_weight = item.weight + edge.weight;
+        if (!IsReached(state, edge.vertex) || candidate_weight < state.weights[edge.vertex]) {
+            Reach(state, edge.vertex, candidate_weight, edge.edge);
+            state.queue.push_back({candidate_weight, edge.vertex});
+            std::push_heap(state.queue.begin(), state.queue.end(), QueueCompare);
+        }
+    }
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::UnpackEdge(EdgeId edge_id, std::vector<EdgeId>& unpack_stack,
+                                              std::vector<EdgeId>& result) const {
+    const size_t stack_base = unpack_stack.size();
+    unpack_stack.push_back(edge_id);
+    while (unpack_stack.size() > stack_base) {
+        const EdgeId current = unpack_stack.back();
+        unpack_stack.pop_back();
+        if (current < graph_.GetEdgeCount()) {
+            result.push_back(current);
+        } else {
+            const auto& shortcut = shortcuts_[current - graph_.GetEdgeCount()];
+            unpack_stack.push_back(shortcut.second);
+            unpack_stack.push_back(shortcut.first);
+        }
+    }
+}
+
+template <typename Weight>
+VertexId ContractionHierarchy<Weight>::GetEdgeFrom(EdgeId edge_id) const {
+    return edge_id < graph_.GetEdgeCount()
+            ? graph_.GetEdge(edge_id).from
+            : shortcuts_[edge_id - graph_.GetEdgeCount()].from;
+}
+
+template <typename Weight>
+VertexId ContractionHierarchy<Weight>::GetEdgeTo(EdgeId edge_id) const {
+    return edge_id < graph_.GetEdgeCount()
+            ? graph_.GetEdge(edge_id).to
+            : shortcuts_[edge_id - graph_.GetEdgeCount()].to;
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::Reach(SearchState& state, VertexId vertex, const Weight& weight,
+                                         EdgeId prev_edge) {
+    state.weights[vertex] = weight;
+    state.prev_edges[vertex] = prev_edge;
+    state.marks[vertex] = state.mark;
+}
+
+template <typename Weight>
+bool ContractionHierarchy<Weight>::IsReached(const SearchState& state, VertexId vertex) {
+    return state.marks[vertex] == state.mark;
+}
+
+template <typename Weight>
+void ContractionHierarchy<Weight>::StartSearch(Scratch& scratch) const {
+    const size_t vertex_count = graph_.GetVertexCount();
+    for (SearchState* state : {&scratch.forward, &scratch.backward}) {
+        state->queue.clear();
+        if (state->marks.size() != vertex_count) {
+            // буфер новый или остался от другого графа
+            state->weights.resize(vertex_count);
+            state->prev_edges.assign(vertex_count, NO_EDGE);
+            state->marks.assign(vertex_count, 0);
+            state->mark = 0;
+        }
+        if (++state->mark == 0) {
+            std::fill(state->marks.begin(), state->marks.end(), 0);
+            state->mark = 1;
+        }
+    }
+}
+
+template <typename Weight>
+const std::vector<size_t>& ContractionHierarchy<Weight>::GetRanks() const {
+    return ranks_;
+}
+
+template <typename Weight>
+const std::vector<typename ContractionHierarchy<Weight>::Shortcut>&
+ContractionHierarchy<Weight>::GetShortcuts() const {
+    return shortcuts_;
+}
+
+}  // namespace graph
@@ -0,0 +1,415 @@
+#pragma once
+
+#include "graph.h"
+#include "router.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// Маршрутизатор, ищущий путь алгоритмом Дейкстры на каждый запрос.
+// В отличие от Router не хранит таблицу всех пар вершин: память O(V + E),
+// построение - только проверка весов рёбер.
+// Поддерживает режим A*: с нижней оценкой оставшегося веса поиск
+// направляется к цели и извлекает из очереди меньше вершин.
+// Рабочие буферы (Scratch) передаёт вызывающий и переиспользует между запросами,
+// поэтому сам поиск ничего не аллоцирует (кроме результата). Маршрутизатор
+// запросами не меняется: запросы с разными Scratch можно выполнять
+// из нескольких потоков одновременно.
+template <typename Weight>
+class DijkstraRouter {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+    struct QueueItem {
+        // для A* - вес маршрута до вершины плюс оценка оставшегося
+        Weight weight;
+        VertexId vertex;
+    };
+
+public:
+    using RouteInfo = typename Router<Weight>::RouteInfo;
+
+    // рабочие буферы поиска одного потока: вершина считается достигнутой,
+    // если её метка совпадает с номером текущего поиска.
+    // Размеры подстраиваются под граф при первом запросе
+    struct Scratch {
+        std::vector<Weight> weights;
+        std::vector<EdgeId> prev_edges;
+        std::vector<uint32_t> search_marks;
+        uint32_t search_mark = 0;
+        std::vector<QueueItem> queue;
+        // оценки A*, вычисляются один раз при первом достижении вершины
+        std::vector<Weight> heuristics;
+    };
+
+    explicit DijkstraRouter(const Graph& graph);
+
+    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to, Scratch& scratch) const;
+    // маршрут в память вызывающего: edges очищается и заполняется рёбрами от первого к последнему
+    std::optional<Weight> BuildRoute(VertexId from, VertexId to, Scratch& scratch, std::vector<EdgeId>& edges) const;
+
+    // Поиск A*: heuristic(vertex) возвращает нижнюю оценку веса маршрута от vertex до to.
+    // Оценка должна быть согласованной: heuristic(u) <= w(u, v) + heuristic(v), heuristic(to) = 0
+    template <typename Heuristic>
+    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to, Heuristic&& heuristic,
+                                        Scratch& scratch) const;
+    template <typename Heuristic>
+    std::optional<Weight> BuildRoute(VertexId from, VertexId to, Heuristic&& heuristic,
+                                     Scratch& scratch, std::vector<EdgeId>& edges) const;
+
+    // число вершин, извлечённых из очереди всеми поисками
+    size_t GetSettledCount() const;
+
+private:
+    // запускает поиск из from, останавливается при извлечении to из очереди
+    // возвращает true, если вершина to достижима
+    template <typename Heuristic>
+    bool Search(VertexId from, VertexId to, Heuristic& heuristic, Scratch& scratch) const;
+    // собирает рёбра маршрута до to по результатам поиска
+    void CollectRouteEdges(VertexId to, const Scratch& scratch, std::vector<EdgeId>& edges) const;
+    // помечает вершину достигнутой в текущем поиске с указанным весом
+    static void Reach(Scratch& scratch, VertexId vertex, const Weight& weight, EdgeId prev_edge);
+    static bool IsReached(const Scratch& scratch, VertexId vertex);
+    // начинает новый поиск без обнуления буферов
+    void StartSearch(Scratch& scratch) const;
+
+    static bool QueueCompare(const QueueItem& lhs, const QueueItem& rhs) {
+        return lhs.weight > rhs.weight;
+    }
+
+    static constexpr Weight ZERO_WEIGHT{};
+    static constexpr EdgeId NO_EDGE = std::numeric_limits<EdgeId>::max();
+
+    const Graph& graph_;
+
+    mutable std::atomic<size_t> settled_count_ = 0;
+};
+
+// Веса кратчайших путей от from до всех вершин графа (nullopt - вершина недостижима).
+// Работает только с переданным буфером, поэтому одновременные вызовы безопасны
+template <typename Weight, typename Id>
+void ComputeShortestPathWeights(const DirectedWeightedGraph<Weight, Id>& graph, VertexId from,
+                                std::vector<std::optional<Weight>>& weights) {
+    if (from >= graph.GetVertexCount()) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    struct QueueItem {
+        Weight weight;
+        VertexId vertex;
+    };
+    const auto queue_compare = [](const QueueItem& lhs, const QueueItem& rhs) {
+        return lhs.weight > rhs.weight;
+    };
+
+    weights.assign(graph.GetVertexCount(), std::nullopt);
+    weights[from] = Weight{};
+    std::vector<QueueItem> queue{{Weight{}, from}};
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), queue_compare);
+        const QueueItem item = queue.back();
+        queue.pop_back();
+        if (*weights[item.vertex] < item.weight) {
+            continue;
+        }
+        for (const auto& edge : graph.GetOutgoingEdges(item.vertex)) {
+            const Weight candidate_weight = item.weight + edge.weight;
+            if (!weights[edge.to] || candidate_weight < *weights[edge.to]) {
+                weights[edge.to] = candidate_weight;
+                queue.push_back({candidate_weight, edge.to});
+                std::push_heap(queue.begin(), queue.end(), queue_compare);
+            }
+        }
+    }
+}
+
+// Рабочие буферы ComputeTargetWeights одного потока, метки работают как в DijkstraRouter.
+// Размеры подстраиваются под граф при первом поиске
+template <typename Weight>
+struct TargetWeightsScratch {
+    struct QueueItem {
+        Weight weight;
+        VertexId vertex;
+    };
+
+    std::vector<Weight> weights;
+    std::vector<uint32_t> search_marks;
+    // вершина - ещё не извлечённая из очереди цель текущего поиска
+    std::vector<uint32_t> target_marks;
+    uint32_t search_mark = 0;
+    std::vector<QueueItem> queue;
+};
+
+// Веса кратчайших путей от from до вершин targets: weights[i] - до targets[i], nullopt - недостижима.
+// Поиск останавливается, как только из очереди извлечены все цели.
+// Работает только с переданными буферами, поэтому одновременные вызовы с разными scratch безопасны
+template <typename Weight, typename Id>
+void ComputeTargetWeights(const DirectedWeightedGraph<Weight, Id>& graph, VertexId from,
+                          const std::vector<VertexId>& targets, std::vector<std::optional<Weight>>& weights,
+                          TargetWeightsScratch<Weight>& scratch) {
+    using QueueItem = typename TargetWeightsScratch<Weight>::QueueItem;
+    const size_t vertex_count = graph.GetVertexCount();
+    if (from >= vertex_count) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    const auto queue_compare = [](const QueueItem& lhs, const QueueItem& rhs) {
+        return lhs.weight > rhs.weight;
+    };
+
+    if (scratch.search_marks.size() != vertex_count) {
+        // буфер новый или остался от другого графа
+        scratch.weights.resize(vertex_count);
+        scratch.search_marks.assign(vertex_count, 0);
+        scratch.target_marks.assign(vertex_count, 0);
+        scratch.search_mark = 0;
+    }
+    if (++scratch.search_mark == 0) {
+        std::fill(scratch.search_marks.begin(), scratch.search_marks.end(), 0);
+        std::fill(scratch.target_marks.begin(), scratch.target_marks.end(), 0);
+        scratch.search_mark = 1;
+    }
+    const uint32_t mark = scratch.search_mark;
+    size_t remaining_count = 0;
+    for (const VertexId target : targets) {
+        if (target >= vertex_count) {
+            throw std::out_of_range("Vertex id is out of range");
+        }
+        if (scratch.target_marks[target] != mark) {
+            scratch.target_marks[target] = mark;
+            ++remaining_count;
+        }
+    }
+
+    scratch.weights[from] = Weight{};
+    scratch.search_marks[from] = mark;
+    scratch.queue.clear();
+    scratch.queue.push_back({Weight{}, from});
+    while (!scratch.queue.empty() && remaining_count > 0) {
+        std::pop_heap(scratch.queue.begin(), scratch.queue.end(), queue_compare);
+        const QueueItem item = scratch.queue.back();
+        scratch.queue.pop_back();
+        if (scratch.weights[item.vertex] < item.weight) {
+            continue;
+        }
+        if (scratch.target_marks[item.vertex] == mark) {
+            // вес цели окончателен; 0 не совпадает ни с одной меткой поиска
+            scratch.target_marks[item.vertex] = 0;
+            --remaining_count;
+        }
+        for (const auto& edge : graph.GetOutgoingEdges(item.vertex)) {
+            const Weight candidate_weight = item.weight + edge.weight;
+            if (scratch.search_marks[edge.to] != mark || candidate_weight < scratch.weights[edge.to]) {
+                scratch.weights[edge.to] = candidate_weight;
+                scratch.search_marks[edge.to] = mark;
+                scratch.queue.push_back({candidate_weight, edge.to});
+                std::push_heap(scratch.queue.begin(), scratch.queue.end(), queue_compare);
+            }
+        }
+    }
+
+    // все достигнутые цели извлечены, остальные недостижимы
+    weights.resize(targets.size());
+    for (size_t i = 0; i < targets.size(); ++i) {
+        weights[i] = scratch.search_marks[targets[i]] == mark ? std::optional<Weight>(scratch.weights[targets[i]])
+                                                              : std::nullopt;
+    }
+}
+
+// Вершины, вес кратчайшего пути до которых из from не больше max_weight, по возрастанию веса.
+// Поиск прекращается, как только фронт превысит max_weight; память и время пропорциональны
+// просмотренной части графа, а не числу вершин. Одновременные вызовы безопасны
+template <typename Weight, typename Id>
+std::vector<std::pair<VertexId, Weight>> ComputeReachableVertices(const DirectedWeightedGraph<Weight, Id>& graph,
+                                                                  VertexId from, const Weight& max_weight) {
+    if (from >= graph.GetVertexCount()) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    struct QueueItem {
+        Weight weight;
+        VertexId vertex;
+    };
+    const auto queue_compare = [](const QueueItem& lhs, const QueueItem& rhs) {
+        return lhs.weight > rhs.weight;
+    };
+
+    std::vector<std::pair<VertexId, Weight>> result;
+    std::unordered_map<VertexId, Weight> weights{{from, Weight{}}};
+    std::vector<QueueItem> queue{{Weight{}, from}};
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), queue_compare);
+        const QueueItem item = queue.back();
+        queue.pop_back();
+        if (max_weight < item.weight) {
+            break;
+        }
+        if (weights.at(item.vertex) < item.weight) {
+            continue;
+        }
+        result.emplace_back(item.vertex, item.weight);
+        for (const auto& edge : graph.GetOutgoingEdges(item.vertex)) {
+            const Weight candidate_weight = item.weight + edge.weight;
+            if (max_weight < candidate_weight) {
+                continue;
+            }
+            auto [it, inserted] = weights.try_emplace(edge.to, candidate_weight);
+            if (inserted || candidate_weight < it->second) {
+                it->second = candidate_weight;
+                queue.push_back({candidate_weight, edge.to});
+                std::push_heap(queue.begin(), queue.end(), queue_compare);
+            }
+        }
+    }
+    return result;
+}
+
+template <typename Weight>
+DijkstraRouter<Weight>::DijkstraRouter(const Graph& graph)
+    : graph_(graph)
+{
+    for (const auto& edge : graph.GetEdges()) {
+        if (edge.weight < ZERO_WEIGHT) {
+            throw std::domain_error("Edges' weights should be non-negative");
+        }
+    }
+}
+
+template <typename Weight>
+std::optional<typename DijkstraRouter<Weight>::RouteInfo>
+DijkstraRouter<Weight>::BuildRoute(VertexId from, VertexId to, Scratch& scratch) const {
+    return BuildRoute(from, to, [](VertexId) {
+        return ZERO_WEIGHT;
+    }, scratch);
+}
+
+template <typename Weight>
+std::optional<Weight> DijkstraRouter<Weight>::BuildRoute(VertexId from, VertexId to, Scratch& scratch,
+                                                         std::vector<EdgeId>& edges) const {
+    return BuildRoute(from, to, [](VertexId) {
+        return ZERO_WEIGHT;
+    }, scratch, edges);
+}
+
+template <typename Weight>
+template <typename Heuristic>
+std::optional<typename DijkstraRouter<Weight>::RouteInfo>
+DijkstraRouter<Weight>::BuildRoute(VertexId from, VertexId to, Heuristic&& heuristic, Scratch& scratch) const {
+    std::vector<EdgeId> edges;
+    auto weight = BuildRoute(from, to, heuristic, scratch, edges);
+    if (!weight) {
+        return std::nullopt;
+    }
+    return RouteInfo{*weight, std::move(edges)};
+}
+
+template <typename Weight>
+template <typename Heuristic>
+std::optional<Weight> DijkstraRouter<Weight>::BuildRoute(VertexId from, VertexId to, Heuristic&& heuristic,
+                                                         Scratch& scratch, std::vector<EdgeId>& edges) const {
+    if (from >= graph_.GetVertexCount() || to >= graph_.GetVertexCount()) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    edges.clear();
+    if (!Search(from, to, heuristic, scratch)) {
+        return std::nullopt;
+    }
+    CollectRouteEdges(to, scratch, edges);
+    return scratch.weights[to];
+}
+
+template <typename Weight>
+size_t DijkstraRouter<Weight>::GetSettledCount() const {
+    return settled_count_.load(std::memory_order_relaxed);
+}
+
+template <typename Weight>
+void DijkstraRouter<Weight>::CollectRouteEdges(VertexId to, const Scratch& scratch,
+                                               std::vector<EdgeId>& edges) const {
+    for (EdgeId edge_id = scratch.prev_edges[to]; edge_id != NO_EDGE;
+         edge_id = scratch.prev_edges[graph_.GetEdge(edge_id).from]) {
+        edges.push_back(edge_id);
+    }
+    std::reverse(edges.begin(), edges.end());
+}
+
+template <typename Weight>
+template <typename Heuristic>
+bool DijkstraRouter<Weight>::Search(VertexId from, VertexId to, Heuristic& heuristic, Scratch& scratch) const {
+    StartSearch(scratch);
+    Reach(scratch, from, ZERO_WEIGHT, NO_EDGE);
+    scratch.heuristics[from] = heuristic(from);
+    scratch.queue.push_back({scratch.heuristics[from], from});
+
+    size_t settled_count = 0;
+    bool is_found = false;
+    while (!scratch.queue.empty()) {
+        std::pop_heap(scratch.queue.begin(), scratch.queue.end(), QueueCompare);
+        const QueueItem item = scratch.queue.back();
+        scratch.queue.pop_back();
+
+        // устаревшая запись: вершина уже извлечена с меньшим весом
+        const Weight weight = scratch.weights[item.vertex];
+        if (weight + scratch.heuristics[item.vertex] < item.weight) {
+            continue;
+        }
+        ++settled_count;
+        if (item.vertex == to) {
+            is_found = true;
+            break;
+        }
+        for (const auto& edge : graph_.GetOutgoingEdges(item.vertex)) {
+            const Weight candidate_weight = weight + edge.weight;
+            const bool is_reached = IsReached(scratch, edge.to);
+            if (!is_reached || candidate_weight < scratch.weights[edge.to]) {
+                Reach(scratch, edge.to, candidate_weight, edge.id);
+                if (!is_reached) {
+                    scratch.heuristics[edge.to] = heuristic(edge.to);
+                }
+                scratch.queue.push_back({candidate_weight + scratch.heuristics[edge.to], edge.to});
+                std::push_heap(scratch.queue.begin(), scratch.queue.end(), QueueCompare);
+            }
+        }
+    }
+    settled_count_.fetch_add(settled_count, std::memory_order_relaxed);
+    return is_found || IsReached(scratch, to);
+}
+
+template <typename Weight>
+void DijkstraRouter<Weight>::Reach(Scratch& scratch, VertexId vertex, const Weight& weight, EdgeId prev_edge) {
+    scratch.weights[vertex] = weight;
+    scratch.prev_edges[vertex] = prev_edge;
+    scratch.search_marks[vertex] = scratch.search_mark;
+}
+
+template <typename Weight>
+bool DijkstraRouter<Weight>::IsReached(const Scratch& scratch, VertexId vertex) {
+    return scratch.search_marks[vertex] == scratch.search_mark;
+}
+
+template <typename Weight>
+void DijkstraRouter<Weight>::StartSearch(Scratch& scratch) const {
+    scratch.queue.clear();
+    const size_t vertex_count = graph_.GetVertexCount();
+    if (scratch.search_marks.size() != vertex_count) {
+        // буфер новый или остался от другого графа
+        scratch.weights.resize(vertex_count);
+        scratch.prev_edges.assign(vertex_count, NO_EDGE);
+        scratch.search_marks.assign(vertex_count, 0);
+        scratch.heuristics.resize(vertex_count);
+        scratch.search_mark = 0;
+    }
+    if (++scratch.search_mark == 0) {
+        // счётчик поисков переполнился - сбрасываем метки один раз
+        std::fill(scratch.search_marks.begin(), scratch.search_marks.end(), 0);
+        scratch.search_mark = 1;
+    }
+}
+
+}  // namespace graph
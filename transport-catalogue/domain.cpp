@@ -1,5 +1,7 @@
 #include "domain.h"
 
+#include <stdexcept>
+
 namespace domain {
 
     bool operator==(const Stop& lhs, const Stop& rhs) {
@@ -10,4 +12,21 @@ namespace domain {
         return (lhs.name == rhs.name);
     }
 
+    bool Bus::HasDistances() const {
+        return !distances.empty();
+    }
+
+    int Bus::GetDistance(size_t from_index, size_t to_index) const {
+        if (!HasDistances()) {
+            throw std::logic_error("Road distances of bus " + name + " are not known");
+        }
+        if (from_index <= to_index) {
+            return distances.at(to_index) - distances.at(from_index);
+        }
+        if (route_type != RouteType::LINEAR) {
+            throw std::out_of_range("Bus " + name + " does not go backward");
+        }
+        return back_distances.at(to_index) - back_distances.at(from_index);
+    }
+
 } // namespace domain
@@ -2,6 +2,7 @@
 
 #include "geo.h"
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,17 @@ struct Bus {
     std::string name;
     RouteType route_type = RouteType::UNKNOWN;
     std::vector<const Stop*> stops;
+    // Пройденное дорожное расстояние: distances[i] - от первой остановки до i-й,
+    // back_distances[i] - от последней до i-й на обратном пути линейного маршрута.
+    // Пусты, пока известны не все расстояния между соседними остановками
+    std::vector<int> distances;
+    std::vector<int> back_distances;
+
+    bool HasDistances() const;
+    // Дорожное расстояние по маршруту от from_index-й остановки до to_index-й,
+    // при from_index > to_index - по обратному пути линейного маршрута
+    int GetDistance(size_t from_index, size_t to_index) const;
+
     friend bool operator==(const Bus& lhs, const Bus& rhs);
 };
 
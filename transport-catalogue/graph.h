@@ -2,102 +2,219 @@
 
 #include "ranges.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace graph {
 
+// Номера вершин и рёбер в интерфейсах. В структурах графа и таблицы маршрутов
+// они хранятся типом Id (параметр шаблона, по умолчанию uint32_t)
 using VertexId = size_t;
 using EdgeId = size_t;
 
+// Преобразование веса в число для плотных таблиц маршрутов и обратно.
+// По умолчанию вес сам является числом; для составных весов
+// шаблон специализируется рядом с определением веса.
 template <typename Weight>
+struct WeightTraits {
+    using Value = Weight;
+
+    static Value ToValue(const Weight& weight) {
+        return weight;
+    }
+    static Weight FromValue(Value value) {
+        return value;
+    }
+};
+
+template <typename Weight, typename Id = uint32_t>
 struct Edge {
-    VertexId from;
-    VertexId to;
+    Id from;
+    Id to;
     Weight weight;
 };
 
-template <typename Weight>
+// Ориентированный взвешенный граф. Номера вершин и рёбер хранятся типом Id:
+// 32-битные номера вдвое уменьшают списки инцидентности и рёбра по сравнению с size_t.
+// Наибольшее значение Id зарезервировано как признак отсутствия ребра, поэтому рёбер
+// должно быть меньше него; при переполнении бросается std::length_error
+template <typename Weight, typename Id = uint32_t>
 class DirectedWeightedGraph {
+    static_assert(std::is_unsigned_v<Id>, "Graph id type should be unsigned");
+
 public:
 
-    using IncidenceList = std::vector<EdgeId>;
+    using IncidenceList = std::vector<Id>;
     using IncidentEdgesRange = ranges::Range<typename IncidenceList::const_iterator>;
 
+    // исходящее ребро в сжатом представлении графа
+    struct OutgoingEdge {
+        Id id;
+        Id to;
+        Weight weight;
+    };
+    using OutgoingEdges = std::vector<OutgoingEdge>;
+    using OutgoingEdgesRange = ranges::Range<typename OutgoingEdges::const_iterator>;
+
 
     DirectedWeightedGraph() = default;
     explicit DirectedWeightedGraph(size_t vertex_count);
-    EdgeId AddEdge(const Edge<Weight>& edge);
+    EdgeId AddEdge(const Edge<Weight, Id>& edge);
 
     size_t GetVertexCount() const;
     size_t GetEdgeCount() const;
-    const Edge<Weight>& GetEdge(EdgeId edge_id) const;
+    const Edge<Weight, Id>& GetEdge(EdgeId edge_id) const;
     IncidentEdgesRange GetIncidentEdges(VertexId vertex) const;
 
+    // Строит сжатое представление (CSR): исходящие рёбра всех вершин лежат подряд
+    // в порядке номеров вершин, а внутри вершины - в порядке списка инцидентности,
+    // поэтому обход рёбер вершины - последовательное чтение без перехода по номеру ребра.
+    // Добавление рёбер и изменяющий доступ к внутренним данным сбрасывают его
+    void Freeze();
+    bool IsFrozen() const;
+    // исходящие рёбра вершины, граф должен быть заморожен
+    OutgoingEdgesRange GetOutgoingEdges(VertexId vertex) const;
+
     // доступ к внутренним данным графа для "ручного" заполнения
-    const std::vector<Edge<Weight>>& GetEdges() const;
-    std::vector<Edge<Weight>>& GetEdges();
+    const std::vector<Edge<Weight, Id>>& GetEdges() const;
+    std::vector<Edge<Weight, Id>>& GetEdges();
     const std::vector<IncidenceList>& GetIncidenceLists() const;
     std::vector<IncidenceList>& GetIncidenceLists();
 
+    static constexpr size_t MAX_ID = std::numeric_limits<Id>::max();
+
 private:
-    std::vector<Edge<Weight>> edges_;
+    void Unfreeze();
+    // бросает std::length_error, если номер ребра не помещается в Id
+    void CheckEdgeCount(size_t edge_count) const;
+
+    std::vector<Edge<Weight, Id>> edges_;
     std::vector<IncidenceList> incidence_lists_;
+
+    // сжатое представление: рёбра вершины v - outgoing_edges_[offsets_[v], offsets_[v + 1])
+    bool is_frozen_ = false;
+    std::vector<Id> offsets_;
+    OutgoingEdges outgoing_edges_;
 };
 
-template <typename Weight>
-DirectedWeightedGraph<Weight>::DirectedWeightedGraph(size_t vertex_count)
-    : incidence_lists_(vertex_count) {
+template <typename Weight, typename Id>
+DirectedWeightedGraph<Weight, Id>::DirectedWeightedGraph(size_t vertex_count) {
+    if (vertex_count > MAX_ID) {
+        throw std::length_error("Too many vertices for the graph id type");
+    }
+    incidence_lists_.resize(vertex_count);
 }
 
-template <typename Weight>
-EdgeId DirectedWeightedGraph<Weight>::AddEdge(const Edge<Weight>& edge) {
+template <typename Weight, typename Id>
+EdgeId DirectedWeightedGraph<Weight, Id>::AddEdge(const Edge<Weight, Id>& edge) {
+    CheckEdgeCount(edges_.size() + 1);
+    Unfreeze();
     edges_.push_back(edge);
-    const EdgeId id = edges_.size() - 1;
+    const Id id = static_cast<Id>(edges_.size() - 1);
     incidence_lists_.at(edge.from).push_back(id);
     return id;
 }
 
-template <typename Weight>
-size_t DirectedWeightedGraph<Weight>::GetVertexCount() const {
+template <typename Weight, typename Id>
+void DirectedWeightedGraph<Weight, Id>::CheckEdgeCount(size_t edge_count) const {
+    if (edge_count > MAX_ID) {
+        throw std::length_error("Too many edges for the graph id type");
+    }
+}
+
+template <typename Weight, typename Id>
+size_t DirectedWeightedGraph<Weight, Id>::GetVertexCount() const {
     return incidence_lists_.size();
 }
 
-template <typename Weight>
-size_t DirectedWeightedGraph<Weight>::GetEdgeCount() const {
+template <typename Weight, typename Id>
+size_t DirectedWeightedGraph<Weight, Id>::GetEdgeCount() const {
     return edges_.size();
 }
 
-template <typename Weight>
-const Edge<Weight>& DirectedWeightedGraph<Weight>::GetEdge(EdgeId edge_id) const {
+template <typename Weight, typename Id>
+const Edge<Weight, Id>& DirectedWeightedGraph<Weight, Id>::GetEdge(EdgeId edge_id) const {
     return edges_.at(edge_id);
 }
 
-template <typename Weight>
-typename DirectedWeightedGraph<Weight>::IncidentEdgesRange
-DirectedWeightedGraph<Weight>::GetIncidentEdges(VertexId vertex) const {
+template <typename Weight, typename Id>
+typename DirectedWeightedGraph<Weight, Id>::IncidentEdgesRange
+DirectedWeightedGraph<Weight, Id>::GetIncidentEdges(VertexId vertex) const {
     return ranges::AsRange(incidence_lists_.at(vertex));
 }
 
-template<typename Weight>
-const std::vector<Edge<Weight>>& DirectedWeightedGraph<Weight>::GetEdges() const {
+template <typename Weight, typename Id>
+void DirectedWeightedGraph<Weight, Id>::Freeze() {
+    if (is_frozen_) {
+        return;
+    }
+    // рёбра могли быть добавлены через GetEdges()
+    CheckEdgeCount(edges_.size());
+    offsets_.assign(1, 0);
+    offsets_.reserve(incidence_lists_.size() + 1);
+    outgoing_edges_.clear();
+    outgoing_edges_.reserve(edges_.size());
+    for (const auto& incidence_list : incidence_lists_) {
+        for (const Id edge_id : incidence_list) {
+            const auto& edge = edges_.at(edge_id);
+            outgoing_edges_.push_back({edge_id, edge.to, edge.weight});
+        }
+        offsets_.push_back(static_cast<Id>(outgoing_edges_.size()));
+    }
+    is_frozen_ = true;
+}
+
+template <typename Weight, typename Id>
+bool DirectedWeightedGraph<Weight, Id>::IsFrozen() const {
+    return is_frozen_;
+}
+
+template <typename Weight, typename Id>
+typename DirectedWeightedGraph<Weight, Id>::OutgoingEdgesRange
+DirectedWeightedGraph<Weight, Id>::GetOutgoingEdges(VertexId vertex) const {
+    if (!is_frozen_) {
+        throw std::logic_error("Graph should be frozen before traversal");
+    }
+    const auto begin = outgoing_edges_.begin();
+    return OutgoingEdgesRange(begin + static_cast<std::ptrdiff_t>(offsets_.at(vertex)),
+                              begin + static_cast<std::ptrdiff_t>(offsets_.at(vertex + 1)));
+}
+
+template <typename Weight, typename Id>
+void DirectedWeightedGraph<Weight, Id>::Unfreeze() {
+    if (is_frozen_) {
+        is_frozen_ = false;
+        offsets_.clear();
+        outgoing_edges_.clear();
+    }
+}
+
+template <typename Weight, typename Id>
+const std::vector<Edge<Weight, Id>>& DirectedWeightedGraph<Weight, Id>::GetEdges() const {
     return edges_;
 }
 
-template<typename Weight>
-std::vector<Edge<Weight>>& DirectedWeightedGraph<Weight>::GetEdges() {
+template <typename Weight, typename Id>
+std::vector<Edge<Weight, Id>>& DirectedWeightedGraph<Weight, Id>::GetEdges() {
+    Unfreeze();
     return edges_;
 }
 
-template<typename Weight>
-std::vector<typename DirectedWeightedGraph<Weight>::IncidenceList>&
-DirectedWeightedGraph<Weight>::GetIncidenceLists() {
+template <typename Weight, typename Id>
+std::vector<typename DirectedWeightedGraph<Weight, Id>::IncidenceList>&
+DirectedWeightedGraph<Weight, Id>::GetIncidenceLists() {
+    Unfreeze();
     return incidence_lists_;
 }
 
-template<typename Weight>
-const std::vector<typename DirectedWeightedGraph<Weight>::IncidenceList>&
-DirectedWeightedGraph<Weight>::GetIncidenceLists() const {
+template <typename Weight, typename Id>
+const std::vector<typename DirectedWeightedGraph<Weight, Id>::IncidenceList>&
+DirectedWeightedGraph<Weight, Id>::GetIncidenceLists() const {
     return incidence_lists_;
 }
 
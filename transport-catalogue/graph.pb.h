@@ -45,40 +45,44 @@ struct TableStruct_graph_2eproto {
 };
 extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_graph_2eproto;
 namespace graph_serialize {
+class ContractionHierarchy;
+struct ContractionHierarchyDefaultTypeInternal;
+extern ContractionHierarchyDefaultTypeInternal _ContractionHierarchy_default_instance_;
 class Edge;
 struct EdgeDefaultTypeInternal;
 extern EdgeDefaultTypeInternal _Edge_default_instance_;
 class Graph;
 struct GraphDefaultTypeInternal;
 extern GraphDefaultTypeInternal _Graph_default_instance_;
+class HubLabels;
+struct HubLabelsDefaultTypeInternal;
+extern HubLabelsDefaultTypeInternal _HubLabels_default_instance_;
 class IncidenceList;
 struct IncidenceListDefaultTypeInternal;
 extern IncidenceListDefaultTypeInternal _IncidenceList_default_instance_;
-class OptionalRouteInternalData;
-struct OptionalRouteInternalDataDefaultTypeInternal;
-extern OptionalRouteInternalDataDefaultTypeInternal _OptionalRouteInternalData_default_instance_;
-class RouteInternalData;
-struct RouteInternalDataDefaultTypeInternal;
-extern RouteInternalDataDefaultTypeInternal _RouteInternalData_default_instance_;
+class Labels;
+struct LabelsDefaultTypeInternal;
+extern LabelsDefaultTypeInternal _Labels_default_instance_;
 class RouteWeight;
 struct RouteWeightDefaultTypeInternal;
 extern RouteWeightDefaultTypeInternal _RouteWeight_default_instance_;
 class Router;
 struct RouterDefaultTypeInternal;
 extern RouterDefaultTypeInternal _Router_default_instance_;
-class RoutesInternalData;
-struct RoutesInternalDataDefaultTypeInternal;
-extern RoutesInternalDataDefaultTypeInternal _RoutesInternalData_default_instance_;
+class Shortcut;
+struct ShortcutDefaultTypeInternal;
+extern ShortcutDefaultTypeInternal _Shortcut_default_instance_;
 }  // namespace graph_serialize
 PROTOBUF_NAMESPACE_OPEN
+template<> ::graph_serialize::ContractionHierarchy* Arena::CreateMaybeMessage<::graph_serialize::ContractionHierarchy>(Arena*);
 template<> ::graph_serialize::Edge* Arena::CreateMaybeMessage<::graph_serialize::Edge>(Arena*);
 template<> ::graph_serialize::Graph* Arena::CreateMaybeMessage<::graph_serialize::Graph>(Arena*);
+template<> ::graph_serialize::HubLabels* Arena::CreateMaybeMessage<::graph_serialize::HubLabels>(Arena*);
 template<> ::graph_serialize::IncidenceList* Arena::CreateMaybeMessage<::graph_serialize::IncidenceList>(Arena*);
-template<> ::graph_serialize::OptionalRouteInternalData* Arena::CreateMaybeMessage<::graph_serialize::OptionalRouteInternalData>(Arena*);
-template<> ::graph_serialize::RouteInternalData* Arena::CreateMaybeMessage<::graph_serialize::RouteInternalData>(Arena*);
+template<> ::graph_serialize::Labels* Arena::CreateMaybeMessage<::graph_serialize::Labels>(Arena*);
 template<> ::graph_serialize::RouteWeight* Arena::CreateMaybeMessage<::graph_serialize::RouteWeight>(Arena*);
 template<> ::graph_serialize::Router* Arena::CreateMaybeMessage<::graph_serialize::Router>(Arena*);
-template<> ::graph_serialize::RoutesInternalData* Arena::CreateMaybeMessage<::graph_serialize::RoutesInternalData>(Arena*);
+template<> ::graph_serialize::Shortcut* Arena::CreateMaybeMessage<::graph_serialize::Shortcut>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 namespace graph_serialize {
 
@@ -772,24 +776,24 @@ class Graph final :
 };
 // -------------------------------------------------------------------
 
-class RouteInternalData final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:graph_serialize.RouteInternalData) */ {
+class Router final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:graph_serialize.Router) */ {
  public:
-  inline RouteInternalData() : RouteInternalData(nullptr) {}
-  ~RouteInternalData() override;
-  explicit PROTOBUF_CONSTEXPR RouteInternalData(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline Router() : Router(nullptr) {}
+  ~Router() override;
+  explicit PROTOBUF_CONSTEXPR Router(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  RouteInternalData(const RouteInternalData& from);
-  RouteInternalData(RouteInternalData&& from) noexcept
-    : RouteInternalData() {
+  Router(const Router& from);
+  Router(Router&& from) noexcept
+    : Router() {
     *this = ::std::move(from);
   }
 
-  inline RouteInternalData& operator=(const RouteInternalData& from) {
+  inline Router& operator=(const Router& from) {
     CopyFrom(from);
     return *this;
   }
-  inline RouteInternalData& operator=(RouteInternalData&& from) noexcept {
+  inline Router& operator=(Router&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -812,25 +816,206 @@ class RouteInternalData final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const RouteInternalData& default_instance() {
+  static const Router& default_instance() {
     return *internal_default_instance();
   }
-  enum OptionalPrevEdgeCase {
-    kPrevEdge = 2,
-    OPTIONAL_PREV_EDGE_NOT_SET = 0,
+  static inline const Router* internal_default_instance() {
+    return reinterpret_cast<const Router*>(
+               &_Router_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    4;
+
+  friend void swap(Router& a, Router& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Router* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Router* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Router* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Router>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Router& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Router& from) {
+    Router::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Router* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "graph_serialize.Router";
+  }
+  protected:
+  explicit Router(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kWeightsFieldNumber = 2,
+    kPrevEdgesFieldNumber = 3,
   };
+  // repeated double weights = 2;
+  int weights_size() const;
+  private:
+  int _internal_weights_size() const;
+  public:
+  void clear_weights();
+  private:
+  double _internal_weights(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >&
+      _internal_weights() const;
+  void _internal_add_weights(double value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >*
+      _internal_mutable_weights();
+  public:
+  double weights(int index) const;
+  void set_weights(int index, double value);
+  void add_weights(double value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >&
+      weights() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >*
+      mutable_weights();
+
+  // repeated uint32 prev_edges = 3;
+  int prev_edges_size() const;
+  private:
+  int _internal_prev_edges_size() const;
+  public:
+  void clear_prev_edges();
+  private:
+  uint32_t _internal_prev_edges(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      _internal_prev_edges() const;
+  void _internal_add_prev_edges(uint32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      _internal_mutable_prev_edges();
+  public:
+  uint32_t prev_edges(int index) const;
+  void set_prev_edges(int index, uint32_t value);
+  void add_prev_edges(uint32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      prev_edges() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      mutable_prev_edges();
+
+  // @@protoc_insertion_point(class_scope:graph_serialize.Router)
+ private:
+  class _Internal;
 
-  static inline const RouteInternalData* internal_default_instance() {
-    return reinterpret_cast<const RouteInternalData*>(
-               &_RouteInternalData_default_instance_);
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< double > weights_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t > prev_edges_;
+    mutable std::atomic<int> _prev_edges_cached_byte_size_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_graph_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Shortcut final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:graph_serialize.Shortcut) */ {
+ public:
+  inline Shortcut() : Shortcut(nullptr) {}
+  ~Shortcut() override;
+  explicit PROTOBUF_CONSTEXPR Shortcut(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Shortcut(const Shortcut& from);
+  Shortcut(Shortcut&& from) noexcept
+    : Shortcut() {
+    *this = ::std::move(from);
+  }
+
+  inline Shortcut& operator=(const Shortcut& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Shortcut& operator=(Shortcut&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Shortcut& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Shortcut* internal_default_instance() {
+    return reinterpret_cast<const Shortcut*>(
+               &_Shortcut_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    4;
+    5;
 
-  friend void swap(RouteInternalData& a, RouteInternalData& b) {
+  friend void swap(Shortcut& a, Shortcut& b) {
     a.Swap(&b);
   }
-  inline void Swap(RouteInternalData* other) {
+  inline void Swap(Shortcut* other) {
     if (other == this) return;
   #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetOwningArena() != nullptr &&
@@ -843,7 +1028,7 @@ class RouteInternalData final :
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(RouteInternalData* other) {
+  void UnsafeArenaSwap(Shortcut* other) {
     if (other == this) return;
     GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
@@ -851,14 +1036,14 @@ class RouteInternalData final :
 
   // implements Message ----------------------------------------------
 
-  RouteInternalData* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
-    return CreateMaybeMessage<RouteInternalData>(arena);
+  Shortcut* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Shortcut>(arena);
   }
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
-  void CopyFrom(const RouteInternalData& from);
+  void CopyFrom(const Shortcut& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom( const RouteInternalData& from) {
-    RouteInternalData::MergeImpl(*this, from);
+  void MergeFrom( const Shortcut& from) {
+    Shortcut::MergeImpl(*this, from);
   }
   private:
   static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
@@ -876,15 +1061,15 @@ class RouteInternalData final :
   void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
-  void InternalSwap(RouteInternalData* other);
+  void InternalSwap(Shortcut* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "graph_serialize.RouteInternalData";
+    return "graph_serialize.Shortcut";
   }
   protected:
-  explicit RouteInternalData(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+  explicit Shortcut(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                        bool is_message_owned = false);
   public:
 
@@ -898,10 +1083,31 @@ class RouteInternalData final :
   // accessors -------------------------------------------------------
 
   enum : int {
-    kTotalTimeFieldNumber = 1,
-    kPrevEdgeFieldNumber = 2,
+    kFromFieldNumber = 1,
+    kToFieldNumber = 2,
+    kTotalTimeFieldNumber = 3,
+    kFirstFieldNumber = 4,
+    kSecondFieldNumber = 5,
   };
-  // double total_time = 1;
+  // uint32 from = 1;
+  void clear_from();
+  uint32_t from() const;
+  void set_from(uint32_t value);
+  private:
+  uint32_t _internal_from() const;
+  void _internal_set_from(uint32_t value);
+  public:
+
+  // uint32 to = 2;
+  void clear_to();
+  uint32_t to() const;
+  void set_to(uint32_t value);
+  private:
+  uint32_t _internal_to() const;
+  void _internal_set_to(uint32_t value);
+  public:
+
+  // double total_time = 3;
   void clear_total_time();
   double total_time() const;
   void set_total_time(double value);
@@ -910,66 +1116,62 @@ class RouteInternalData final :
   void _internal_set_total_time(double value);
   public:
 
-  // uint32 prev_edge = 2;
-  bool has_prev_edge() const;
+  // uint32 first = 4;
+  void clear_first();
+  uint32_t first() const;
+  void set_first(uint32_t value);
   private:
-  bool _internal_has_prev_edge() const;
+  uint32_t _internal_first() const;
+  void _internal_set_first(uint32_t value);
   public:
-  void clear_prev_edge();
-  uint32_t prev_edge() const;
-  void set_prev_edge(uint32_t value);
+
+  // uint32 second = 5;
+  void clear_second();
+  uint32_t second() const;
+  void set_second(uint32_t value);
   private:
-  uint32_t _internal_prev_edge() const;
-  void _internal_set_prev_edge(uint32_t value);
+  uint32_t _internal_second() const;
+  void _internal_set_second(uint32_t value);
   public:
 
-  void clear_optional_prev_edge();
-  OptionalPrevEdgeCase optional_prev_edge_case() const;
-  // @@protoc_insertion_point(class_scope:graph_serialize.RouteInternalData)
+  // @@protoc_insertion_point(class_scope:graph_serialize.Shortcut)
  private:
   class _Internal;
-  void set_has_prev_edge();
-
-  inline bool has_optional_prev_edge() const;
-  inline void clear_has_optional_prev_edge();
 
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
+    uint32_t from_;
+    uint32_t to_;
     double total_time_;
-    union OptionalPrevEdgeUnion {
-      constexpr OptionalPrevEdgeUnion() : _constinit_{} {}
-        ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
-      uint32_t prev_edge_;
-    } optional_prev_edge_;
+    uint32_t first_;
+    uint32_t second_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-    uint32_t _oneof_case_[1];
-
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_graph_2eproto;
 };
 // -------------------------------------------------------------------
 
-class OptionalRouteInternalData final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:graph_serialize.OptionalRouteInternalData) */ {
+class ContractionHierarchy final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:graph_serialize.ContractionHierarchy) */ {
  public:
-  inline OptionalRouteInternalData() : OptionalRouteInternalData(nullptr) {}
-  ~OptionalRouteInternalData() override;
-  explicit PROTOBUF_CONSTEXPR OptionalRouteInternalData(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline ContractionHierarchy() : ContractionHierarchy(nullptr) {}
+  ~ContractionHierarchy() override;
+  explicit PROTOBUF_CONSTEXPR ContractionHierarchy(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  OptionalRouteInternalData(const OptionalRouteInternalData& from);
-  OptionalRouteInternalData(OptionalRouteInternalData&& from) noexcept
-    : OptionalRouteInternalData() {
+  ContractionHierarchy(const ContractionHierarchy& from);
+  ContractionHierarchy(ContractionHierarchy&& from) noexcept
+    : ContractionHierarchy() {
     *this = ::std::move(from);
   }
 
-  inline OptionalRouteInternalData& operator=(const OptionalRouteInternalData& from) {
+  inline ContractionHierarchy& operator=(const ContractionHierarchy& from) {
     CopyFrom(from);
     return *this;
   }
-  inline OptionalRouteInternalData& operator=(OptionalRouteInternalData&& from) noexcept {
+  inline ContractionHierarchy& operator=(ContractionHierarchy&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -992,25 +1194,20 @@ class OptionalRouteInternalData final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const OptionalRouteInternalData& default_instance() {
+  static const ContractionHierarchy& default_instance() {
     return *internal_default_instance();
   }
-  enum OptionalRouteInternalDataCase {
-    kRouteInternalData = 1,
-    OPTIONAL_ROUTE_INTERNAL_DATA_NOT_SET = 0,
-  };
-
-  static inline const OptionalRouteInternalData* internal_default_instance() {
-    return reinterpret_cast<const OptionalRouteInternalData*>(
-               &_OptionalRouteInternalData_default_instance_);
+  static inline const ContractionHierarchy* internal_default_instance() {
+    return reinterpret_cast<const ContractionHierarchy*>(
+               &_ContractionHierarchy_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    5;
+    6;
 
-  friend void swap(OptionalRouteInternalData& a, OptionalRouteInternalData& b) {
+  friend void swap(ContractionHierarchy& a, ContractionHierarchy& b) {
     a.Swap(&b);
   }
-  inline void Swap(OptionalRouteInternalData* other) {
+  inline void Swap(ContractionHierarchy* other) {
     if (other == this) return;
   #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetOwningArena() != nullptr &&
@@ -1023,7 +1220,7 @@ class OptionalRouteInternalData final :
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(OptionalRouteInternalData* other) {
+  void UnsafeArenaSwap(ContractionHierarchy* other) {
     if (other == this) return;
     GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
@@ -1031,14 +1228,14 @@ class OptionalRouteInternalData final :
 
   // implements Message ----------------------------------------------
 
-  OptionalRouteInternalData* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
-    return CreateMaybeMessage<OptionalRouteInternalData>(arena);
+  ContractionHierarchy* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<ContractionHierarchy>(arena);
   }
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
-  void CopyFrom(const OptionalRouteInternalData& from);
+  void CopyFrom(const ContractionHierarchy& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom( const OptionalRouteInternalData& from) {
-    OptionalRouteInternalData::MergeImpl(*this, from);
+  void MergeFrom( const ContractionHierarchy& from) {
+    ContractionHierarchy::MergeImpl(*this, from);
   }
   private:
   static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
@@ -1056,15 +1253,15 @@ class OptionalRouteInternalData final :
   void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
-  void InternalSwap(OptionalRouteInternalData* other);
+  void InternalSwap(ContractionHierarchy* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "graph_serialize.OptionalRouteInternalData";
+    return "graph_serialize.ContractionHierarchy";
   }
   protected:
-  explicit OptionalRouteInternalData(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+  explicit ContractionHierarchy(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                        bool is_message_owned = false);
   public:
 
@@ -1078,72 +1275,85 @@ class OptionalRouteInternalData final :
   // accessors -------------------------------------------------------
 
   enum : int {
-    kRouteInternalDataFieldNumber = 1,
+    kRanksFieldNumber = 1,
+    kShortcutsFieldNumber = 2,
   };
-  // .graph_serialize.RouteInternalData route_internal_data = 1;
-  bool has_route_internal_data() const;
+  // repeated uint32 ranks = 1;
+  int ranks_size() const;
+  private:
+  int _internal_ranks_size() const;
+  public:
+  void clear_ranks();
+  private:
+  uint32_t _internal_ranks(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      _internal_ranks() const;
+  void _internal_add_ranks(uint32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      _internal_mutable_ranks();
+  public:
+  uint32_t ranks(int index) const;
+  void set_ranks(int index, uint32_t value);
+  void add_ranks(uint32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      ranks() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      mutable_ranks();
+
+  // repeated .graph_serialize.Shortcut shortcuts = 2;
+  int shortcuts_size() const;
   private:
-  bool _internal_has_route_internal_data() const;
+  int _internal_shortcuts_size() const;
   public:
-  void clear_route_internal_data();
-  const ::graph_serialize::RouteInternalData& route_internal_data() const;
-  PROTOBUF_NODISCARD ::graph_serialize::RouteInternalData* release_route_internal_data();
-  ::graph_serialize::RouteInternalData* mutable_route_internal_data();
-  void set_allocated_route_internal_data(::graph_serialize::RouteInternalData* route_internal_data);
+  void clear_shortcuts();
+  ::graph_serialize::Shortcut* mutable_shortcuts(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::Shortcut >*
+      mutable_shortcuts();
   private:
-  const ::graph_serialize::RouteInternalData& _internal_route_internal_data() const;
-  ::graph_serialize::RouteInternalData* _internal_mutable_route_internal_data();
+  const ::graph_serialize::Shortcut& _internal_shortcuts(int index) const;
+  ::graph_serialize::Shortcut* _internal_add_shortcuts();
   public:
-  void unsafe_arena_set_allocated_route_internal_data(
-      ::graph_serialize::RouteInternalData* route_internal_data);
-  ::graph_serialize::RouteInternalData* unsafe_arena_release_route_internal_data();
+  const ::graph_serialize::Shortcut& shortcuts(int index) const;
+  ::graph_serialize::Shortcut* add_shortcuts();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::Shortcut >&
+      shortcuts() const;
 
-  void clear_optional_route_internal_data();
-  OptionalRouteInternalDataCase optional_route_internal_data_case() const;
-  // @@protoc_insertion_point(class_scope:graph_serialize.OptionalRouteInternalData)
+  // @@protoc_insertion_point(class_scope:graph_serialize.ContractionHierarchy)
  private:
   class _Internal;
-  void set_has_route_internal_data();
-
-  inline bool has_optional_route_internal_data() const;
-  inline void clear_has_optional_route_internal_data();
 
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
-    union OptionalRouteInternalDataUnion {
-      constexpr OptionalRouteInternalDataUnion() : _constinit_{} {}
-        ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
-      ::graph_serialize::RouteInternalData* route_internal_data_;
-    } optional_route_internal_data_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t > ranks_;
+    mutable std::atomic<int> _ranks_cached_byte_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::Shortcut > shortcuts_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-    uint32_t _oneof_case_[1];
-
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_graph_2eproto;
 };
 // -------------------------------------------------------------------
 
-class RoutesInternalData final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:graph_serialize.RoutesInternalData) */ {
+class Labels final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:graph_serialize.Labels) */ {
  public:
-  inline RoutesInternalData() : RoutesInternalData(nullptr) {}
-  ~RoutesInternalData() override;
-  explicit PROTOBUF_CONSTEXPR RoutesInternalData(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline Labels() : Labels(nullptr) {}
+  ~Labels() override;
+  explicit PROTOBUF_CONSTEXPR Labels(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  RoutesInternalData(const RoutesInternalData& from);
-  RoutesInternalData(RoutesInternalData&& from) noexcept
-    : RoutesInternalData() {
+  Labels(const Labels& from);
+  Labels(Labels&& from) noexcept
+    : Labels() {
     *this = ::std::move(from);
   }
 
-  inline RoutesInternalData& operator=(const RoutesInternalData& from) {
+  inline Labels& operator=(const Labels& from) {
     CopyFrom(from);
     return *this;
   }
-  inline RoutesInternalData& operator=(RoutesInternalData&& from) noexcept {
+  inline Labels& operator=(Labels&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -1166,20 +1376,20 @@ class RoutesInternalData final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const RoutesInternalData& default_instance() {
+  static const Labels& default_instance() {
     return *internal_default_instance();
   }
-  static inline const RoutesInternalData* internal_default_instance() {
-    return reinterpret_cast<const RoutesInternalData*>(
-               &_RoutesInternalData_default_instance_);
+  static inline const Labels* internal_default_instance() {
+    return reinterpret_cast<const Labels*>(
+               &_Labels_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    6;
+    7;
 
-  friend void swap(RoutesInternalData& a, RoutesInternalData& b) {
+  friend void swap(Labels& a, Labels& b) {
     a.Swap(&b);
   }
-  inline void Swap(RoutesInternalData* other) {
+  inline void Swap(Labels* other) {
     if (other == this) return;
   #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetOwningArena() != nullptr &&
@@ -1192,7 +1402,7 @@ class RoutesInternalData final :
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(RoutesInternalData* other) {
+  void UnsafeArenaSwap(Labels* other) {
     if (other == this) return;
     GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
@@ -1200,14 +1410,14 @@ class RoutesInternalData final :
 
   // implements Message ----------------------------------------------
 
-  RoutesInternalData* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
-    return CreateMaybeMessage<RoutesInternalData>(arena);
+  Labels* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Labels>(arena);
   }
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
-  void CopyFrom(const RoutesInternalData& from);
+  void CopyFrom(const Labels& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom( const RoutesInternalData& from) {
-    RoutesInternalData::MergeImpl(*this, from);
+  void MergeFrom( const Labels& from) {
+    Labels::MergeImpl(*this, from);
   }
   private:
   static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
@@ -1225,15 +1435,15 @@ class RoutesInternalData final :
   void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
-  void InternalSwap(RoutesInternalData* other);
+  void InternalSwap(Labels* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "graph_serialize.RoutesInternalData";
+    return "graph_serialize.Labels";
   }
   protected:
-  explicit RoutesInternalData(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+  explicit Labels(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                        bool is_message_owned = false);
   public:
 
@@ -1247,27 +1457,77 @@ class RoutesInternalData final :
   // accessors -------------------------------------------------------
 
   enum : int {
-    kRoutesInternalDataFieldNumber = 1,
+    kOffsetsFieldNumber = 1,
+    kHubsFieldNumber = 2,
+    kWeightsFieldNumber = 3,
   };
-  // repeated .graph_serialize.OptionalRouteInternalData routes_internal_data = 1;
-  int routes_internal_data_size() const;
+  // repeated uint64 offsets = 1;
+  int offsets_size() const;
   private:
-  int _internal_routes_internal_data_size() const;
+  int _internal_offsets_size() const;
   public:
-  void clear_routes_internal_data();
-  ::graph_serialize::OptionalRouteInternalData* mutable_routes_internal_data(int index);
-  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::OptionalRouteInternalData >*
-      mutable_routes_internal_data();
+  void clear_offsets();
   private:
-  const ::graph_serialize::OptionalRouteInternalData& _internal_routes_internal_data(int index) const;
-  ::graph_serialize::OptionalRouteInternalData* _internal_add_routes_internal_data();
+  uint64_t _internal_offsets(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      _internal_offsets() const;
+  void _internal_add_offsets(uint64_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      _internal_mutable_offsets();
   public:
-  const ::graph_serialize::OptionalRouteInternalData& routes_internal_data(int index) const;
-  ::graph_serialize::OptionalRouteInternalData* add_routes_internal_data();
-  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::OptionalRouteInternalData >&
-      routes_internal_data() const;
+  uint64_t offsets(int index) const;
+  void set_offsets(int index, uint64_t value);
+  void add_offsets(uint64_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      offsets() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      mutable_offsets();
+
+  // repeated uint32 hubs = 2;
+  int hubs_size() const;
+  private:
+  int _internal_hubs_size() const;
+  public:
+  void clear_hubs();
+  private:
+  uint32_t _internal_hubs(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      _internal_hubs() const;
+  void _internal_add_hubs(uint32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      _internal_mutable_hubs();
+  public:
+  uint32_t hubs(int index) const;
+  void set_hubs(int index, uint32_t value);
+  void add_hubs(uint32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      hubs() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      mutable_hubs();
 
-  // @@protoc_insertion_point(class_scope:graph_serialize.RoutesInternalData)
+  // repeated double weights = 3;
+  int weights_size() const;
+  private:
+  int _internal_weights_size() const;
+  public:
+  void clear_weights();
+  private:
+  double _internal_weights(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >&
+      _internal_weights() const;
+  void _internal_add_weights(double value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >*
+      _internal_mutable_weights();
+  public:
+  double weights(int index) const;
+  void set_weights(int index, double value);
+  void add_weights(double value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >&
+      weights() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >*
+      mutable_weights();
+
+  // @@protoc_insertion_point(class_scope:graph_serialize.Labels)
  private:
   class _Internal;
 
@@ -1275,7 +1535,11 @@ class RoutesInternalData final :
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
-    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::OptionalRouteInternalData > routes_internal_data_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t > offsets_;
+    mutable std::atomic<int> _offsets_cached_byte_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t > hubs_;
+    mutable std::atomic<int> _hubs_cached_byte_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< double > weights_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -1283,24 +1547,24 @@ class RoutesInternalData final :
 };
 // -------------------------------------------------------------------
 
-class Router final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:graph_serialize.Router) */ {
+class HubLabels final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:graph_serialize.HubLabels) */ {
  public:
-  inline Router() : Router(nullptr) {}
-  ~Router() override;
-  explicit PROTOBUF_CONSTEXPR Router(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline HubLabels() : HubLabels(nullptr) {}
+  ~HubLabels() override;
+  explicit PROTOBUF_CONSTEXPR HubLabels(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  Router(const Router& from);
-  Router(Router&& from) noexcept
-    : Router() {
+  HubLabels(const HubLabels& from);
+  HubLabels(HubLabels&& from) noexcept
+    : HubLabels() {
     *this = ::std::move(from);
   }
 
-  inline Router& operator=(const Router& from) {
+  inline HubLabels& operator=(const HubLabels& from) {
     CopyFrom(from);
     return *this;
   }
-  inline Router& operator=(Router&& from) noexcept {
+  inline HubLabels& operator=(HubLabels&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -1323,20 +1587,20 @@ class Router final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const Router& default_instance() {
+  static const HubLabels& default_instance() {
     return *internal_default_instance();
   }
-  static inline const Router* internal_default_instance() {
-    return reinterpret_cast<const Router*>(
-               &_Router_default_instance_);
+  static inline const HubLabels* internal_default_instance() {
+    return reinterpret_cast<const HubLabels*>(
+               &_HubLabels_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    7;
+    8;
 
-  friend void swap(Router& a, Router& b) {
+  friend void swap(HubLabels& a, HubLabels& b) {
     a.Swap(&b);
   }
-  inline void Swap(Router* other) {
+  inline void Swap(HubLabels* other) {
     if (other == this) return;
   #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetOwningArena() != nullptr &&
@@ -1349,7 +1613,7 @@ class Router final :
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(Router* other) {
+  void UnsafeArenaSwap(HubLabels* other) {
     if (other == this) return;
     GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
@@ -1357,14 +1621,14 @@ class Router final :
 
   // implements Message ----------------------------------------------
 
-  Router* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
-    return CreateMaybeMessage<Router>(arena);
+  HubLabels* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<HubLabels>(arena);
   }
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
-  void CopyFrom(const Router& from);
+  void CopyFrom(const HubLabels& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom( const Router& from) {
-    Router::MergeImpl(*this, from);
+  void MergeFrom( const HubLabels& from) {
+    HubLabels::MergeImpl(*this, from);
   }
   private:
   static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
@@ -1382,15 +1646,15 @@ class Router final :
   void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
-  void InternalSwap(Router* other);
+  void InternalSwap(HubLabels* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "graph_serialize.Router";
+    return "graph_serialize.HubLabels";
   }
   protected:
-  explicit Router(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+  explicit HubLabels(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                        bool is_message_owned = false);
   public:
 
@@ -1404,27 +1668,46 @@ class Router final :
   // accessors -------------------------------------------------------
 
   enum : int {
-    kRoutesInternalDataFieldNumber = 1,
+    kForwardFieldNumber = 1,
+    kBackwardFieldNumber = 2,
   };
-  // repeated .graph_serialize.RoutesInternalData routes_internal_data = 1;
-  int routes_internal_data_size() const;
+  // .graph_serialize.Labels forward = 1;
+  bool has_forward() const;
   private:
-  int _internal_routes_internal_data_size() const;
+  bool _internal_has_forward() const;
   public:
-  void clear_routes_internal_data();
-  ::graph_serialize::RoutesInternalData* mutable_routes_internal_data(int index);
-  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::RoutesInternalData >*
-      mutable_routes_internal_data();
+  void clear_forward();
+  const ::graph_serialize::Labels& forward() const;
+  PROTOBUF_NODISCARD ::graph_serialize::Labels* release_forward();
+  ::graph_serialize::Labels* mutable_forward();
+  void set_allocated_forward(::graph_serialize::Labels* forward);
   private:
-  const ::graph_serialize::RoutesInternalData& _internal_routes_internal_data(int index) const;
-  ::graph_serialize::RoutesInternalData* _internal_add_routes_internal_data();
+  const ::graph_serialize::Labels& _internal_forward() const;
+  ::graph_serialize::Labels* _internal_mutable_forward();
   public:
-  const ::graph_serialize::RoutesInternalData& routes_internal_data(int index) const;
-  ::graph_serialize::RoutesInternalData* add_routes_internal_data();
-  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::RoutesInternalData >&
-      routes_internal_data() const;
+  void unsafe_arena_set_allocated_forward(
+      ::graph_serialize::Labels* forward);
+  ::graph_serialize::Labels* unsafe_arena_release_forward();
 
-  // @@protoc_insertion_point(class_scope:graph_serialize.Router)
+  // .graph_serialize.Labels backward = 2;
+  bool has_backward() const;
+  private:
+  bool _internal_has_backward() const;
+  public:
+  void clear_backward();
+  const ::graph_serialize::Labels& backward() const;
+  PROTOBUF_NODISCARD ::graph_serialize::Labels* release_backward();
+  ::graph_serialize::Labels* mutable_backward();
+  void set_allocated_backward(::graph_serialize::Labels* backward);
+  private:
+  const ::graph_serialize::Labels& _internal_backward() const;
+  ::graph_serialize::Labels* _internal_mutable_backward();
+  public:
+  void unsafe_arena_set_allocated_backward(
+      ::graph_serialize::Labels* backward);
+  ::graph_serialize::Labels* unsafe_arena_release_backward();
+
+  // @@protoc_insertion_point(class_scope:graph_serialize.HubLabels)
  private:
   class _Internal;
 
@@ -1432,7 +1715,8 @@ class Router final :
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
-    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::RoutesInternalData > routes_internal_data_;
+    ::graph_serialize::Labels* forward_;
+    ::graph_serialize::Labels* backward_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -1780,248 +2064,624 @@ Graph::incidence_lists() const {
 
 // -------------------------------------------------------------------
 
-// RouteInternalData
+// Router
+
+// repeated double weights = 2;
+inline int Router::_internal_weights_size() const {
+  return _impl_.weights_.size();
+}
+inline int Router::weights_size() const {
+  return _internal_weights_size();
+}
+inline void Router::clear_weights() {
+  _impl_.weights_.Clear();
+}
+inline double Router::_internal_weights(int index) const {
+  return _impl_.weights_.Get(index);
+}
+inline double Router::weights(int index) const {
+  // @@protoc_insertion_point(field_get:graph_serialize.Router.weights)
+  return _internal_weights(index);
+}
+inline void Router::set_weights(int index, double value) {
+  _impl_.weights_.Set(index, value);
+  // @@protoc_insertion_point(field_set:graph_serialize.Router.weights)
+}
+inline void Router::_internal_add_weights(double value) {
+  _impl_.weights_.Add(value);
+}
+inline void Router::add_weights(double value) {
+  _internal_add_weights(value);
+  // @@protoc_insertion_point(field_add:graph_serialize.Router.weights)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >&
+Router::_internal_weights() const {
+  return _impl_.weights_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >&
+Router::weights() const {
+  // @@protoc_insertion_point(field_list:graph_serialize.Router.weights)
+  return _internal_weights();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >*
+Router::_internal_mutable_weights() {
+  return &_impl_.weights_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >*
+Router::mutable_weights() {
+  // @@protoc_insertion_point(field_mutable_list:graph_serialize.Router.weights)
+  return _internal_mutable_weights();
+}
+
+// repeated uint32 prev_edges = 3;
+inline int Router::_internal_prev_edges_size() const {
+  return _impl_.prev_edges_.size();
+}
+inline int Router::prev_edges_size() const {
+  return _internal_prev_edges_size();
+}
+inline void Router::clear_prev_edges() {
+  _impl_.prev_edges_.Clear();
+}
+inline uint32_t Router::_internal_prev_edges(int index) const {
+  return _impl_.prev_edges_.Get(index);
+}
+inline uint32_t Router::prev_edges(int index) const {
+  // @@protoc_insertion_point(field_get:graph_serialize.Router.prev_edges)
+  return _internal_prev_edges(index);
+}
+inline void Router::set_prev_edges(int index, uint32_t value) {
+  _impl_.prev_edges_.Set(index, value);
+  // @@protoc_insertion_point(field_set:graph_serialize.Router.prev_edges)
+}
+inline void Router::_internal_add_prev_edges(uint32_t value) {
+  _impl_.prev_edges_.Add(value);
+}
+inline void Router::add_prev_edges(uint32_t value) {
+  _internal_add_prev_edges(value);
+  // @@protoc_insertion_point(field_add:graph_serialize.Router.prev_edges)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+Router::_internal_prev_edges() const {
+  return _impl_.prev_edges_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+Router::prev_edges() const {
+  // @@protoc_insertion_point(field_list:graph_serialize.Router.prev_edges)
+  return _internal_prev_edges();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+Router::_internal_mutable_prev_edges() {
+  return &_impl_.prev_edges_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+Router::mutable_prev_edges() {
+  // @@protoc_insertion_point(field_mutable_list:graph_serialize.Router.prev_edges)
+  return _internal_mutable_prev_edges();
+}
+
+// -------------------------------------------------------------------
+
+// Shortcut
 
-// double total_time = 1;
-inline void RouteInternalData::clear_total_time() {
+// uint32 from = 1;
+inline void Shortcut::clear_from() {
+  _impl_.from_ = 0u;
+}
+inline uint32_t Shortcut::_internal_from() const {
+  return _impl_.from_;
+}
+inline uint32_t Shortcut::from() const {
+  // @@protoc_insertion_point(field_get:graph_serialize.Shortcut.from)
+  return _internal_from();
+}
+inline void Shortcut::_internal_set_from(uint32_t value) {
+  
+  _impl_.from_ = value;
+}
+inline void Shortcut::set_from(uint32_t value) {
+  _internal_set_from(value);
+  // @@protoc_insertion_point(field_set:graph_serialize.Shortcut.from)
+}
+
+// uint32 to = 2;
+inline void Shortcut::clear_to() {
+  _impl_.to_ = 0u;
+}
+inline uint32_t Shortcut::_internal_to() const {
+  return _impl_.to_;
+}
+inline uint32_t Shortcut::to() const {
+  // @@protoc_insertion_point(field_get:graph_serialize.Shortcut.to)
+  return _internal_to();
+}
+inline void Shortcut::_internal_set_to(uint32_t value) {
+  
+  _impl_.to_ = value;
+}
+inline void Shortcut::set_to(uint32_t value) {
+  _internal_set_to(value);
+  // @@protoc_insertion_point(field_set:graph_serialize.Shortcut.to)
+}
+
+// double total_time = 3;
+inline void Shortcut::clear_total_time() {
   _impl_.total_time_ = 0;
 }
-inline double RouteInternalData::_internal_total_time() const {
+inline double Shortcut::_internal_total_time() const {
   return _impl_.total_time_;
 }
-inline double RouteInternalData::total_time() const {
-  // @@protoc_insertion_point(field_get:graph_serialize.RouteInternalData.total_time)
+inline double Shortcut::total_time() const {
+  // @@protoc_insertion_point(field_get:graph_serialize.Shortcut.total_time)
   return _internal_total_time();
 }
-inline void RouteInternalData::_internal_set_total_time(double value) {
+inline void Shortcut::_internal_set_total_time(double value) {
   
   _impl_.total_time_ = value;
 }
-inline void RouteInternalData::set_total_time(double value) {
+inline void Shortcut::set_total_time(double value) {
   _internal_set_total_time(value);
-  // @@protoc_insertion_point(field_set:graph_serialize.RouteInternalData.total_time)
+  // @@protoc_insertion_point(field_set:graph_serialize.Shortcut.total_time)
 }
 
-// uint32 prev_edge = 2;
-inline bool RouteInternalData::_internal_has_prev_edge() const {
-  return optional_prev_edge_case() == kPrevEdge;
+// uint32 first = 4;
+inline void Shortcut::clear_first() {
+  _impl_.first_ = 0u;
 }
-inline bool RouteInternalData::has_prev_edge() const {
-  return _internal_has_prev_edge();
+inline uint32_t Shortcut::_internal_first() const {
+  return _impl_.first_;
 }
-inline void RouteInternalData::set_has_prev_edge() {
-  _impl_._oneof_case_[0] = kPrevEdge;
+inline uint32_t Shortcut::first() const {
+  // @@protoc_insertion_point(field_get:graph_serialize.Shortcut.first)
+  return _internal_first();
 }
-inline void RouteInternalData::clear_prev_edge() {
-  if (_internal_has_prev_edge()) {
-    _impl_.optional_prev_edge_.prev_edge_ = 0u;
-    clear_has_optional_prev_edge();
-  }
-}
-inline uint32_t RouteInternalData::_internal_prev_edge() const {
-  if (_internal_has_prev_edge()) {
-    return _impl_.optional_prev_edge_.prev_edge_;
-  }
-  return 0u;
+inline void Shortcut::_internal_set_first(uint32_t value) {
+  
+  _impl_.first_ = value;
 }
-inline void RouteInternalData::_internal_set_prev_edge(uint32_t value) {
-  if (!_internal_has_prev_edge()) {
-    clear_optional_prev_edge();
-    set_has_prev_edge();
-  }
-  _impl_.optional_prev_edge_.prev_edge_ = value;
+inline void Shortcut::set_first(uint32_t value) {
+  _internal_set_first(value);
+  // @@protoc_insertion_point(field_set:graph_serialize.Shortcut.first)
 }
-inline uint32_t RouteInternalData::prev_edge() const {
-  // @@protoc_insertion_point(field_get:graph_serialize.RouteInternalData.prev_edge)
-  return _internal_prev_edge();
+
+// uint32 second = 5;
+inline void Shortcut::clear_second() {
+  _impl_.second_ = 0u;
 }
-inline void RouteInternalData::set_prev_edge(uint32_t value) {
-  _internal_set_prev_edge(value);
-  // @@protoc_insertion_point(field_set:graph_serialize.RouteInternalData.prev_edge)
+inline uint32_t Shortcut::_internal_second() const {
+  return _impl_.second_;
 }
-
-inline bool RouteInternalData::has_optional_prev_edge() const {
-  return optional_prev_edge_case() != OPTIONAL_PREV_EDGE_NOT_SET;
+inline uint32_t Shortcut::second() const {
+  // @@protoc_insertion_point(field_get:graph_serialize.Shortcut.second)
+  return _internal_second();
 }
-inline void RouteInternalData::clear_has_optional_prev_edge() {
-  _impl_._oneof_case_[0] = OPTIONAL_PREV_EDGE_NOT_SET;
+inline void Shortcut::_internal_set_second(uint32_t value) {
+  
+  _impl_.second_ = value;
 }
-inline RouteInternalData::OptionalPrevEdgeCase RouteInternalData::optional_prev_edge_case() const {
-  return RouteInternalData::OptionalPrevEdgeCase(_impl_._oneof_case_[0]);
+inline void Shortcut::set_second(uint32_t value) {
+  _internal_set_second(value);
+  // @@protoc_insertion_point(field_set:graph_serialize.Shortcut.second)
 }
+
 // -------------------------------------------------------------------
 
-// OptionalRouteInternalData
+// ContractionHierarchy
 
-// .graph_serialize.RouteInternalData route_internal_data = 1;
-inline bool OptionalRouteInternalData::_internal_has_route_internal_data() const {
-  return optional_route_internal_data_case() == kRouteInternalData;
+// repeated uint32 ranks = 1;
+inline int ContractionHierarchy::_internal_ranks_size() const {
+  return _impl_.ranks_.size();
 }
-inline bool OptionalRouteInternalData::has_route_internal_data() const {
-  return _internal_has_route_internal_data();
+inline int ContractionHierarchy::ranks_size() const {
+  return _internal_ranks_size();
 }
-inline void OptionalRouteInternalData::set_has_route_internal_data() {
-  _impl_._oneof_case_[0] = kRouteInternalData;
+inline void ContractionHierarchy::clear_ranks() {
+  _impl_.ranks_.Clear();
 }
-inline void OptionalRouteInternalData::clear_route_internal_data() {
-  if (_internal_has_route_internal_data()) {
-    if (GetArenaForAllocation() == nullptr) {
-      delete _impl_.optional_route_internal_data_.route_internal_data_;
-    }
-    clear_has_optional_route_internal_data();
-  }
+inline uint32_t ContractionHierarchy::_internal_ranks(int index) const {
+  return _impl_.ranks_.Get(index);
 }
-inline ::graph_serialize::RouteInternalData* OptionalRouteInternalData::release_route_internal_data() {
-  // @@protoc_insertion_point(field_release:graph_serialize.OptionalRouteInternalData.route_internal_data)
-  if (_internal_has_route_internal_data()) {
-    clear_has_optional_route_internal_data();
-    ::graph_serialize::RouteInternalData* temp = _impl_.optional_route_internal_data_.route_internal_data_;
-    if (GetArenaForAllocation() != nullptr) {
-      temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
-    }
-    _impl_.optional_route_internal_data_.route_internal_data_ = nullptr;
-    return temp;
-  } else {
-    return nullptr;
-  }
+inline uint32_t ContractionHierarchy::ranks(int index) const {
+  // @@protoc_insertion_point(field_get:graph_serialize.ContractionHierarchy.ranks)
+  return _internal_ranks(index);
 }
-inline const ::graph_serialize::RouteInternalData& OptionalRouteInternalData::_internal_route_internal_data() const {
-  return _internal_has_route_internal_data()
-      ? *_impl_.optional_route_internal_data_.route_internal_data_
-      : reinterpret_cast< ::graph_serialize::RouteInternalData&>(::graph_serialize::_RouteInternalData_default_instance_);
+inline void ContractionHierarchy::set_ranks(int index, uint32_t value) {
+  _impl_.ranks_.Set(index, value);
+  // @@protoc_insertion_point(field_set:graph_serialize.ContractionHierarchy.ranks)
 }
-inline const ::graph_serialize::RouteInternalData& OptionalRouteInternalData::route_internal_data() const {
-  // @@protoc_insertion_point(field_get:graph_serialize.OptionalRouteInternalData.route_internal_data)
-  return _internal_route_internal_data();
+inline void ContractionHierarchy::_internal_add_ranks(uint32_t value) {
+  _impl_.ranks_.Add(value);
 }
-inline ::graph_serialize::RouteInternalData* OptionalRouteInternalData::unsafe_arena_release_route_internal_data() {
-  // @@protoc_insertion_point(field_unsafe_arena_release:graph_serialize.OptionalRouteInternalData.route_internal_data)
-  if (_internal_has_route_internal_data()) {
-    clear_has_optional_route_internal_data();
-    ::graph_serialize::RouteInternalData* temp = _impl_.optional_route_internal_data_.route_internal_data_;
-    _impl_.optional_route_internal_data_.route_internal_data_ = nullptr;
-    return temp;
-  } else {
-    return nullptr;
-  }
+inline void ContractionHierarchy::add_ranks(uint32_t value) {
+  _internal_add_ranks(value);
+  // @@protoc_insertion_point(field_add:graph_serialize.ContractionHierarchy.ranks)
 }
-inline void OptionalRouteInternalData::unsafe_arena_set_allocated_route_internal_data(::graph_serialize::RouteInternalData* route_internal_data) {
-  clear_optional_route_internal_data();
-  if (route_internal_data) {
-    set_has_route_internal_data();
-    _impl_.optional_route_internal_data_.route_internal_data_ = route_internal_data;
-  }
-  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:graph_serialize.OptionalRouteInternalData.route_internal_data)
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+ContractionHierarchy::_internal_ranks() const {
+  return _impl_.ranks_;
 }
-inline ::graph_serialize::RouteInternalData* OptionalRouteInternalData::_internal_mutable_route_internal_data() {
-  if (!_internal_has_route_internal_data()) {
-    clear_optional_route_internal_data();
-    set_has_route_internal_data();
-    _impl_.optional_route_internal_data_.route_internal_data_ = CreateMaybeMessage< ::graph_serialize::RouteInternalData >(GetArenaForAllocation());
-  }
-  return _impl_.optional_route_internal_data_.route_internal_data_;
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+ContractionHierarchy::ranks() const {
+  // @@protoc_insertion_point(field_list:graph_serialize.ContractionHierarchy.ranks)
+  return _internal_ranks();
 }
-inline ::graph_serialize::RouteInternalData* OptionalRouteInternalData::mutable_route_internal_data() {
-  ::graph_serialize::RouteInternalData* _msg = _internal_mutable_route_internal_data();
-  // @@protoc_insertion_point(field_mutable:graph_serialize.OptionalRouteInternalData.route_internal_data)
-  return _msg;
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+ContractionHierarchy::_internal_mutable_ranks() {
+  return &_impl_.ranks_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+ContractionHierarchy::mutable_ranks() {
+  // @@protoc_insertion_point(field_mutable_list:graph_serialize.ContractionHierarchy.ranks)
+  return _internal_mutable_ranks();
 }
 
-inline bool OptionalRouteInternalData::has_optional_route_internal_data() const {
-  return optional_route_internal_data_case() != OPTIONAL_ROUTE_INTERNAL_DATA_NOT_SET;
+// repeated .graph_serialize.Shortcut shortcuts = 2;
+inline int ContractionHierarchy::_internal_shortcuts_size() const {
+  return _impl_.shortcuts_.size();
+}
+inline int ContractionHierarchy::shortcuts_size() const {
+  return _internal_shortcuts_size();
 }
-inline void OptionalRouteInternalData::clear_has_optional_route_internal_data() {
-  _impl_._oneof_case_[0] = OPTIONAL_ROUTE_INTERNAL_DATA_NOT_SET;
+inline void ContractionHierarchy::clear_shortcuts() {
+  _impl_.shortcuts_.Clear();
 }
-inline OptionalRouteInternalData::OptionalRouteInternalDataCase OptionalRouteInternalData::optional_route_internal_data_case() const {
-  return OptionalRouteInternalData::OptionalRouteInternalDataCase(_impl_._oneof_case_[0]);
+inline ::graph_serialize::Shortcut* ContractionHierarchy::mutable_shortcuts(int index) {
+  // @@protoc_insertion_point(field_mutable:graph_serialize.ContractionHierarchy.shortcuts)
+  return _impl_.shortcuts_.Mutable(index);
 }
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::Shortcut >*
+ContractionHierarchy::mutable_shortcuts() {
+  // @@protoc_insertion_point(field_mutable_list:graph_serialize.ContractionHierarchy.shortcuts)
+  return &_impl_.shortcuts_;
+}
+inline const ::graph_serialize::Shortcut& ContractionHierarchy::_internal_shortcuts(int index) const {
+  return _impl_.shortcuts_.Get(index);
+}
+inline const ::graph_serialize::Shortcut& ContractionHierarchy::shortcuts(int index) const {
+  // @@protoc_insertion_point(field_get:graph_serialize.ContractionHierarchy.shortcuts)
+  return _internal_shortcuts(index);
+}
+inline ::graph_serialize::Shortcut* ContractionHierarchy::_internal_add_shortcuts() {
+  return _impl_.shortcuts_.Add();
+}
+inline ::graph_serialize::Shortcut* ContractionHierarchy::add_shortcuts() {
+  ::graph_serialize::Shortcut* _add = _internal_add_shortcuts();
+  // @@protoc_insertion_point(field_add:graph_serialize.ContractionHierarchy.shortcuts)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::Shortcut >&
+ContractionHierarchy::shortcuts() const {
+  // @@protoc_insertion_point(field_list:graph_serialize.ContractionHierarchy.shortcuts)
+  return _impl_.shortcuts_;
+}
+
 // -------------------------------------------------------------------
 
-// RoutesInternalData
+// Labels
 
-// repeated .graph_serialize.OptionalRouteInternalData routes_internal_data = 1;
-inline int RoutesInternalData::_internal_routes_internal_data_size() const {
-  return _impl_.routes_internal_data_.size();
+// repeated uint64 offsets = 1;
+inline int Labels::_internal_offsets_size() const {
+  return _impl_.offsets_.size();
 }
-inline int RoutesInternalData::routes_internal_data_size() const {
-  return _internal_routes_internal_data_size();
+inline int Labels::offsets_size() const {
+  return _internal_offsets_size();
 }
-inline void RoutesInternalData::clear_routes_internal_data() {
-  _impl_.routes_internal_data_.Clear();
+inline void Labels::clear_offsets() {
+  _impl_.offsets_.Clear();
 }
-inline ::graph_serialize::OptionalRouteInternalData* RoutesInternalData::mutable_routes_internal_data(int index) {
-  // @@protoc_insertion_point(field_mutable:graph_serialize.RoutesInternalData.routes_internal_data)
-  return _impl_.routes_internal_data_.Mutable(index);
+inline uint64_t Labels::_internal_offsets(int index) const {
+  return _impl_.offsets_.Get(index);
 }
-inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::OptionalRouteInternalData >*
-RoutesInternalData::mutable_routes_internal_data() {
-  // @@protoc_insertion_point(field_mutable_list:graph_serialize.RoutesInternalData.routes_internal_data)
-  return &_impl_.routes_internal_data_;
+inline uint64_t Labels::offsets(int index) const {
+  // @@protoc_insertion_point(field_get:graph_serialize.Labels.offsets)
+  return _internal_offsets(index);
 }
-inline const ::graph_serialize::OptionalRouteInternalData& RoutesInternalData::_internal_routes_internal_data(int index) const {
-  return _impl_.routes_internal_data_.Get(index);
+inline void Labels::set_offsets(int index, uint64_t value) {
+  _impl_.offsets_.Set(index, value);
+  // @@protoc_insertion_point(field_set:graph_serialize.Labels.offsets)
 }
-inline const ::graph_serialize::OptionalRouteInternalData& RoutesInternalData::routes_internal_data(int index) const {
-  // @@protoc_insertion_point(field_get:graph_serialize.RoutesInternalData.routes_internal_data)
-  return _internal_routes_internal_data(index);
+inline void Labels::_internal_add_offsets(uint64_t value) {
+  _impl_.offsets_.Add(value);
 }
-inline ::graph_serialize::OptionalRouteInternalData* RoutesInternalData::_internal_add_routes_internal_data() {
-  return _impl_.routes_internal_data_.Add();
+inline void Labels::add_offsets(uint64_t value) {
+  _internal_add_offsets(value);
+  // @@protoc_insertion_point(field_add:graph_serialize.Labels.offsets)
 }
-inline ::graph_serialize::OptionalRouteInternalData* RoutesInternalData::add_routes_internal_data() {
-  ::graph_serialize::OptionalRouteInternalData* _add = _internal_add_routes_internal_data();
-  // @@protoc_insertion_point(field_add:graph_serialize.RoutesInternalData.routes_internal_data)
-  return _add;
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+Labels::_internal_offsets() const {
+  return _impl_.offsets_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+Labels::offsets() const {
+  // @@protoc_insertion_point(field_list:graph_serialize.Labels.offsets)
+  return _internal_offsets();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+Labels::_internal_mutable_offsets() {
+  return &_impl_.offsets_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+Labels::mutable_offsets() {
+  // @@protoc_insertion_point(field_mutable_list:graph_serialize.Labels.offsets)
+  return _internal_mutable_offsets();
+}
+
+// repeated uint32 hubs = 2;
+inline int Labels::_internal_hubs_size() const {
+  return _impl_.hubs_.size();
+}
+inline int Labels::hubs_size() const {
+  return _internal_hubs_size();
+}
+inline void Labels::clear_hubs() {
+  _impl_.hubs_.Clear();
+}
+inline uint32_t Labels::_internal_hubs(int index) const {
+  return _impl_.hubs_.Get(index);
+}
+inline uint32_t Labels::hubs(int index) const {
+  // @@protoc_insertion_point(field_get:graph_serialize.Labels.hubs)
+  return _internal_hubs(index);
+}
+inline void Labels::set_hubs(int index, uint32_t value) {
+  _impl_.hubs_.Set(index, value);
+  // @@protoc_insertion_point(field_set:graph_serialize.Labels.hubs)
+}
+inline void Labels::_internal_add_hubs(uint32_t value) {
+  _impl_.hubs_.Add(value);
+}
+inline void Labels::add_hubs(uint32_t value) {
+  _internal_add_hubs(value);
+  // @@protoc_insertion_point(field_add:graph_serialize.Labels.hubs)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+Labels::_internal_hubs() const {
+  return _impl_.hubs_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+Labels::hubs() const {
+  // @@protoc_insertion_point(field_list:graph_serialize.Labels.hubs)
+  return _internal_hubs();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+Labels::_internal_mutable_hubs() {
+  return &_impl_.hubs_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+Labels::mutable_hubs() {
+  // @@protoc_insertion_point(field_mutable_list:graph_serialize.Labels.hubs)
+  return _internal_mutable_hubs();
+}
+
+// repeated double weights = 3;
+inline int Labels::_internal_weights_size() const {
+  return _impl_.weights_.size();
+}
+inline int Labels::weights_size() const {
+  return _internal_weights_size();
+}
+inline void Labels::clear_weights() {
+  _impl_.weights_.Clear();
+}
+inline double Labels::_internal_weights(int index) const {
+  return _impl_.weights_.Get(index);
+}
+inline double Labels::weights(int index) const {
+  // @@protoc_insertion_point(field_get:graph_serialize.Labels.weights)
+  return _internal_weights(index);
+}
+inline void Labels::set_weights(int index, double value) {
+  _impl_.weights_.Set(index, value);
+  // @@protoc_insertion_point(field_set:graph_serialize.Labels.weights)
+}
+inline void Labels::_internal_add_weights(double value) {
+  _impl_.weights_.Add(value);
+}
+inline void Labels::add_weights(double value) {
+  _internal_add_weights(value);
+  // @@protoc_insertion_point(field_add:graph_serialize.Labels.weights)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >&
+Labels::_internal_weights() const {
+  return _impl_.weights_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >&
+Labels::weights() const {
+  // @@protoc_insertion_point(field_list:graph_serialize.Labels.weights)
+  return _internal_weights();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >*
+Labels::_internal_mutable_weights() {
+  return &_impl_.weights_;
 }
-inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::OptionalRouteInternalData >&
-RoutesInternalData::routes_internal_data() const {
-  // @@protoc_insertion_point(field_list:graph_serialize.RoutesInternalData.routes_internal_data)
-  return _impl_.routes_internal_data_;
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< double >*
+Labels::mutable_weights() {
+  // @@protoc_insertion_point(field_mutable_list:graph_serialize.Labels.weights)
+  return _internal_mutable_weights();
 }
 
 // -------------------------------------------------------------------
 
-// Router
+// HubLabels
 
-// repeated .graph_serialize.RoutesInternalData routes_internal_data = 1;
-inline int Router::_internal_routes_internal_data_size() const {
-  return _impl_.routes_internal_data_.size();
+// .graph_serialize.Labels forward = 1;
+inline bool HubLabels::_internal_has_forward() const {
+  return this != internal_default_instance() && _impl_.forward_ != nullptr;
 }
-inline int Router::routes_internal_data_size() const {
-  return _internal_routes_internal_data_size();
+inline bool HubLabels::has_forward() const {
+  return _internal_has_forward();
 }
-inline void Router::clear_routes_internal_data() {
-  _impl_.routes_internal_data_.Clear();
+inline void HubLabels::clear_forward() {
+  if (GetArenaForAllocation() == nullptr && _impl_.forward_ != nullptr) {
+    delete _impl_.forward_;
+  }
+  _impl_.forward_ = nullptr;
 }
-inline ::graph_serialize::RoutesInternalData* Router::mutable_routes_internal_data(int index) {
-  // @@protoc_insertion_point(field_mutable:graph_serialize.Router.routes_internal_data)
-  return _impl_.routes_internal_data_.Mutable(index);
+inline const ::graph_serialize::Labels& HubLabels::_internal_forward() const {
+  const ::graph_serialize::Labels* p = _impl_.forward_;
+  return p != nullptr ? *p : reinterpret_cast<const ::graph_serialize::Labels&>(
+      ::graph_serialize::_Labels_default_instance_);
 }
-inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::RoutesInternalData >*
-Router::mutable_routes_internal_data() {
-  // @@protoc_insertion_point(field_mutable_list:graph_serialize.Router.routes_internal_data)
-  return &_impl_.routes_internal_data_;
+inline const ::graph_serialize::Labels& HubLabels::forward() const {
+  // @@protoc_insertion_point(field_get:graph_serialize.HubLabels.forward)
+  return _internal_forward();
 }
-inline const ::graph_serialize::RoutesInternalData& Router::_internal_routes_internal_data(int index) const {
-  return _impl_.routes_internal_data_.Get(index);
+inline void HubLabels::unsafe_arena_set_allocated_forward(
+    ::graph_serialize::Labels* forward) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.forward_);
+  }
+  _impl_.forward_ = forward;
+  if (forward) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:graph_serialize.HubLabels.forward)
 }
-inline const ::graph_serialize::RoutesInternalData& Router::routes_internal_data(int index) const {
-  // @@protoc_insertion_point(field_get:graph_serialize.Router.routes_internal_data)
-  return _internal_routes_internal_data(index);
+inline ::graph_serialize::Labels* HubLabels::release_forward() {
+  
+  ::graph_serialize::Labels* temp = _impl_.forward_;
+  _impl_.forward_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
 }
-inline ::graph_serialize::RoutesInternalData* Router::_internal_add_routes_internal_data() {
-  return _impl_.routes_internal_data_.Add();
+inline ::graph_serialize::Labels* HubLabels::unsafe_arena_release_forward() {
+  // @@protoc_insertion_point(field_release:graph_serialize.HubLabels.forward)
+  
+  ::graph_serialize::Labels* temp = _impl_.forward_;
+  _impl_.forward_ = nullptr;
+  return temp;
 }
-inline ::graph_serialize::RoutesInternalData* Router::add_routes_internal_data() {
-  ::graph_serialize::RoutesInternalData* _add = _internal_add_routes_internal_data();
-  // @@protoc_insertion_point(field_add:graph_serialize.Router.routes_internal_data)
-  return _add;
+inline ::graph_serialize::Labels* HubLabels::_internal_mutable_forward() {
+  
+  if (_impl_.forward_ == nullptr) {
+    auto* p = CreateMaybeMessage<::graph_serialize::Labels>(GetArenaForAllocation());
+    _impl_.forward_ = p;
+  }
+  return _impl_.forward_;
 }
-inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::RoutesInternalData >&
-Router::routes_internal_data() const {
-  // @@protoc_insertion_point(field_list:graph_serialize.Router.routes_internal_data)
-  return _impl_.routes_internal_data_;
+inline ::graph_serialize::Labels* HubLabels::mutable_forward() {
+  ::graph_serialize::Labels* _msg = _internal_mutable_forward();
+  // @@protoc_insertion_point(field_mutable:graph_serialize.HubLabels.forward)
+  return _msg;
+}
+inline void HubLabels::set_allocated_forward(::graph_serialize::Labels* forward) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.forward_;
+  }
+  if (forward) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(forward);
+    if (message_arena != submessage_arena) {
+      forward = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, forward, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  _impl_.forward_ = forward;
+  // @@protoc_insertion_point(field_set_allocated:graph_serialize.HubLabels.forward)
+}
+
+// .graph_serialize.Labels backward = 2;
+inline bool HubLabels::_internal_has_backward() const {
+  return this != internal_default_instance() && _impl_.backward_ != nullptr;
+}
+inline bool HubLabels::has_backward() const {
+  return _internal_has_backward();
+}
+inline void HubLabels::clear_backward() {
+  if (GetArenaForAllocation() == nullptr && _impl_.backward_ != nullptr) {
+    delete _impl_.backward_;
+  }
+  _impl_.backward_ = nullptr;
+}
+inline const ::graph_serialize::Labels& HubLabels::_internal_backward() const {
+  const ::graph_serialize::Labels* p = _impl_.backward_;
+  return p != nullptr ? *p : reinterpret_cast<const ::graph_serialize::Labels&>(
+      ::graph_serialize::_Labels_default_instance_);
+}
+inline const ::graph_serialize::Labels& HubLabels::backward() const {
+  // @@protoc_insertion_point(field_get:graph_serialize.HubLabels.backward)
+  return _internal_backward();
+}
+inline void HubLabels::unsafe_arena_set_allocated_backward(
+    ::graph_serialize::Labels* backward) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.backward_);
+  }
+  _impl_.backward_ = backward;
+  if (backward) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:graph_serialize.HubLabels.backward)
+}
+inline ::graph_serialize::Labels* HubLabels::release_backward() {
+  
+  ::graph_serialize::Labels* temp = _impl_.backward_;
+  _impl_.backward_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::graph_serialize::Labels* HubLabels::unsafe_arena_release_backward() {
+  // @@protoc_insertion_point(field_release:graph_serialize.HubLabels.backward)
+  
+  ::graph_serialize::Labels* temp = _impl_.backward_;
+  _impl_.backward_ = nullptr;
+  return temp;
+}
+inline ::graph_serialize::Labels* HubLabels::_internal_mutable_backward() {
+  
+  if (_impl_.backward_ == nullptr) {
+    auto* p = CreateMaybeMessage<::graph_serialize::Labels>(GetArenaForAllocation());
+    _impl_.backward_ = p;
+  }
+  return _impl_.backward_;
+}
+inline ::graph_serialize::Labels* HubLabels::mutable_backward() {
+  ::graph_serialize::Labels* _msg = _internal_mutable_backward();
+  // @@protoc_insertion_point(field_mutable:graph_serialize.HubLabels.backward)
+  return _msg;
+}
+inline void HubLabels::set_allocated_backward(::graph_serialize::Labels* backward) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.backward_;
+  }
+  if (backward) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(backward);
+    if (message_arena != submessage_arena) {
+      backward = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, backward, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  _impl_.backward_ = backward;
+  // @@protoc_insertion_point(field_set_allocated:graph_serialize.HubLabels.backward)
 }
 
 #ifdef __GNUC__
@@ -2041,6 +2701,8 @@ Router::routes_internal_data() const {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -0,0 +1,408 @@
+#pragma once
+
+#include "graph.h"
+#include "router.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// Метки опорных вершин (hub labeling) для вычисления веса маршрута без поиска.
+// Каждой вершине v сопоставлены прямые метки (h, вес v -> h) и обратные метки (h, вес h -> v);
+// для любой пары вершин кратчайший путь проходит через опорную вершину, общую для прямых
+// меток начала и обратных меток конца. Вес маршрута - минимум сумм по общим опорным вершинам,
+// метки упорядочены по опорным вершинам, и запрос - это слияние двух отсортированных массивов.
+// Метки строятся отсечённым поиском (pruned landmark labeling): вершины обрабатываются
+// по убыванию важности (числа кратчайших путей через вершину), и поиск из вершины не продолжается там, где уже
+// построенные метки дают путь не тяжелее найденного.
+// Опорные вершины в метках задаются рангами (номерами в порядке обработки).
+// Метки дают только вес, маршрут по рёбрам строится другими алгоритмами.
+template <typename Weight>
+class HubLabels {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+public:
+    using Value = typename WeightTraits<Weight>::Value;
+
+    // метки всех вершин подряд: метки вершины v - [offsets[v], offsets[v + 1])
+    // по возрастанию ранга опорной вершины
+    struct Labels {
+        std::vector<size_t> offsets;
+        std::vector<uint32_t> hubs;
+        std::vector<Value> weights;
+    };
+
+    // строит метки по замороженному графу
+    explicit HubLabels(const Graph& graph);
+    // восстанавливает ранее построенные метки (например, при десериализации)
+    HubLabels(Labels forward_labels, Labels backward_labels);
+
+    // вес маршрута от from до to, nullopt - маршрута нет
+    std::optional<Value> ComputeRouteWeight(VertexId from, VertexId to) const;
+
+    size_t GetVertexCount() const;
+    // общее число меток в обоих направлениях
+    size_t GetLabelCount() const;
+
+    // доступ к внутренним данным
+    const Labels& GetForwardLabels() const;
+    const Labels& GetBackwardLabels() const;
+
+private:
+    class Builder;
+
+    static void CheckLabels(const Labels& labels, size_t vertex_count);
+
+    static constexpr Value UNREACHABLE = std::numeric_limits<Value>::infinity();
+
+    Labels forward_labels_;
+    Labels backward_labels_;
+};
+
+// Построитель меток: для каждой вершины в порядке важности - прямой и обратный
+// отсечённые поиски Дейкстры, метки накапливаются в списках по вершинам
+template <typename Weight>
+class HubLabels<Weight>::Builder {
+public:
+    explicit Builder(const Graph& graph)
+        : graph_(graph)
+        , vertex_count_(graph.GetVertexCount())
+        , forward_labels_(vertex_count_)
+        , backward_labels_(vertex_count_)
+        , weights_(vertex_count_, UNREACHABLE)
+        , hub_weights_(vertex_count_, UNREACHABLE) {
+        if (vertex_count_ > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("Too many vertices for hub labels");
+        }
+        BuildReverseGraph();
+    }
+
+    void Build(Labels& forward_labels, Labels& backward_labels) {
+        const std::vector<VertexId> order = MakeOrder();
+
+        for (uint32_t rank = 0; rank < vertex_count_; ++rank) {
+            // обратные метки вершин: веса от опорной вершины, отсечение по её прямым меткам
+            PrunedSearch(order[rank], rank, false);
+            // прямые метки вершин: веса до опорной вершины, отсечение по её обратным меткам
+            PrunedSearch(order[rank], rank, true);
+        }
+        Flatten(forward_labels_, forward_labels);
+        Flatten(backward_labels_, backward_labels);
+    }
+
+private:
+    // число деревьев кратчайших путей для оценки важности вершин
+    static constexpr size_t SAMPLE_COUNT = 32;
+
+    using Label = std::pair<uint32_t, Value>;
+    using VertexLabels = std::vector<std::vector<Label>>;
+
+    struct ReverseEdge {
+        VertexId from;
+        Value weight;
+    };
+
+    struct QueueItem {
+        Value weight;
+        VertexId vertex;
+    };
+
+    static bool QueueCompare(const QueueItem& lhs, const QueueItem& rhs) {
+        return lhs.weight > rhs.weight;
+    }
+
+    // Порядок вершин по убыванию важности. Важность - число кратчайших путей через вершину
+    // в деревьях кратчайших путей из нескольких вершин (размер её поддерева), при равенстве -
+    // число рёбер. Опорные вершины, покрывающие много путей, сильнее отсекают следующие поиски
+    std::vector<VertexId> MakeOrder() {
+        std::vector<size_t> importance(vertex_count_, 0);
+        std::vector<size_t> degrees(vertex_count_, 0);
+        for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+            const auto edges = graph_.GetOutgoingEdges(vertex);
+            degrees[vertex] = static_cast<size_t>(std::distance(edges.begin(), edges.end()))
+                    + (reverse_offsets_[vertex + 1] - reverse_offsets_[vertex]);
+        }
+
+        const size_t sample_count = std::min(SAMPLE_COUNT, vertex_count_);
+        std::vector<VertexId> parents(vertex_count_);
+        std::vector<VertexId> settled;
+        std::vector<size_t> subtree_sizes(vertex_count_, 0);
+        for (size_t sample = 0; sample < sample_count; ++sample) {
+            const VertexId root = sample * vertex_count_ / sample_count;
+            ComputeShortestPathTree(root, parents, settled);
+            // размеры поддеревьев накапливаются от листьев, извлечённых последними
+            for (auto it = settled.rbegin(); it != settled.rend(); ++it) {
+                subtree_sizes[*it] += 1;
+                importance[*it] += subtree_sizes[*it];
+                if (*it != root) {
+                    subtree_sizes[parents[*it]] += subtree_sizes[*it];
+                }
+            }
+            for (const VertexId vertex : settled) {
+                subtree_sizes[vertex] = 0;
+            }
+        }
+
+        std::vector<VertexId> order(vertex_count_);
+        for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+            order[vertex] = vertex;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](VertexId lhs, VertexId rhs) {
+            return std::pair(importance[lhs], degrees[lhs]) > std::pair(importance[rhs], degrees[rhs]);
+        });
+        return order;
+    }
+
+    // поиск Дейкстры из root по исходящим рёбрам: предки вершин и вершины в порядке извлечения
+    void ComputeShortestPathTree(VertexId root, std::vector<VertexId>& parents, std::vector<VertexId>& settled) {
+        settled.clear();
+        queue_.clear();
+        weights_[root] = 0;
+        reached_.push_back(root);
+        queue_.push_back({0, root});
+        while (!queue_.empty()) {
+            std::pop_heap(queue_.begin(), queue_.end(), QueueCompare);
+            const QueueItem item = queue_.back();
+            queue_.pop_back();
+            if (weights_[item.vertex] < item.weight) {
+                continue;
+            }
+            settled.push_back(item.vertex);
+            for (const auto& edge : graph_.GetOutgoingEdges(item.vertex)) {
+                const Value candidate_weight = item.weight + WeightTraits<Weight>::ToValue(edge.weight);
+                if (candidate_weight < weights_[edge.to]) {
+                    if (weights_[edge.to] == UNREACHABLE) {
+                        reached_.push_back(edge.to);
+                    }
+                    weights_[edge.to] = candidate_weight;
+                    parents[edge.to] = item.vertex;
+                    queue_.push_back({candidate_weight, edge.to});
+                    std::push_heap(queue_.begin(), queue_.end(), QueueCompare);
+                }
+            }
+        }
+        for (const VertexId vertex : reached_) {
+            weights_[vertex] = UNREACHABLE;
+        }
+        reached_.clear();
+    }
+
+    void BuildReverseGraph() {
+        reverse_offsets_.assign(vertex_count_ + 1, 0);
+        for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+            for (const auto& edge : graph_.GetOutgoingEdges(vertex)) {
+                if (edge.weight < Weight{}) {
+                    throw std::domain_error("Edges' weights should be non-negative");
+                }
+                ++reverse_offsets_[edge.to + 1];
+            }
+        }
+        for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+            reverse_offsets_[vertex + 1] += reverse_offsets_[vertex];
+        }
+        reverse_edges_.resize(reverse_offsets_.back());
+        std::vector<size_t> positions(reverse_offsets_.begin(), reverse_offsets_.end() - 1);
+        for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+            for (const auto& edge : graph_.GetOutgoingEdges(vertex)) {
+                reverse_edges_[positions[edge.to]++] = {vertex, WeightTraits<Weight>::ToValue(edge.weight)};
+            }
+        }
+    }
+
+    // Поиск из опорной вершины hub по исходящим (forward == false) или входящим рёбрам.
+    // Вершина, до которой уже построенные метки дают путь не тяжелее, не получает метку
+    // и не продолжает поиск
+    void PrunedSearch(VertexId hub, uint32_t rank, bool forward) {
+        VertexLabels& labels = forward ? forward_labels_ : backward_labels_;
+        // метки опорной вершины с другой стороны пути: по рангам для проверки за размер метки вершины
+        const VertexLabels& hub_labels = forward ? backward_labels_ : forward_labels_;
+        for (const auto& [hub_rank, weight] : hub_labels[hub]) {
+            hub_weights_[hub_rank] = weight;
+        }
+
+        queue_.clear();
+        weights_[hub] = 0;
+        reached_.push_back(hub);
+        queue_.push_back({0, hub});
+        while (!queue_.empty()) {
+            std::pop_heap(queue_.begin(), queue_.end(), QueueCompare);
+            const QueueItem item = queue_.back();
+            queue_.pop_back();
+            if (weights_[item.vertex] < item.weight) {
+                continue;
+            }
+            if (IsCovered(labels[item.vertex], item.weight)) {
+                continue;
+            }
+            labels[item.vertex].push_back({rank, item.weight});
+
+            const auto relax = [&](VertexId vertex, Value edge_weight) {
+                const Value candidate_weight = item.weight + edge_weight;
+                if (candidate_weight < weights_[vertex]) {
+                    if (weights_[vertex] == UNREACHABLE) {
+                        reached_.push_back(vertex);
+                    }
+                    weights_[vertex] = candidate_weight;
+                    queue_.push_back({candidate_weight, vertex});
+                    std::push_heap(queue_.begin(), queue_.end(), QueueCompare);
+                }
+            };
+            if (forward) {
+                for (size_t index = reverse_offsets_[item.vertex]; index < reverse_offsets_[item.vertex + 1]; ++index) {
+                    relax(reverse_edges_[index].from, reverse_edges_[index].weight);
+                }
+            } else {
+                for (const auto& edge : graph_.GetOutgoingEdges(item.vertex)) {
+                    relax(edge.to, WeightTraits<Weight>::ToValue(edge.weight));
+                }
+            }
+        }
+
+        for (const VertexId vertex : reached_) {
+            weights_[vertex] = UNREACHABLE;
+        }
+        reached_.clear();
+        for (const auto& label : hub_labels[hub]) {
+            hub_weights_[label.first] = UNREACHABLE;
+        }
+    }
+
+    // есть ли путь через уже построенные опорные вершины не тяжелее weight
+    bool IsCovered(const std::vector<Label>& vertex_labels, Value weight) const {
+        for (const auto& [hub_rank, hub_weight] : vertex_labels) {
+            if (!(weight < hub_weights_[hub_rank] + hub_weight)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void Flatten(VertexLabels& vertex_labels, Labels& result) {
+        result.offsets.assign(1, 0);
+        result.offsets.reserve(vertex_labels.size() + 1);
+        for (const auto& labels : vertex_labels) {
+            result.offsets.push_back(result.offsets.back() + labels.size());
+        }
+        result.hubs.reserve(result.offsets.back());
+        result.weights.reserve(result.offsets.back());
+        for (auto& labels : vertex_labels) {
+            for (const auto& [hub_rank, weight] : labels) {
+                result.hubs.push_back(hub_rank);
+                result.weights.push_back(weight);
+            }
+            labels.clear();
+            labels.shrink_to_fit();
+        }
+    }
+
+    const Graph& graph_;
+    const size_t vertex_count_;
+
+    std::vector<size_t> reverse_offsets_;
+    std::vector<ReverseEdge> reverse_edges_;
+
+    VertexLabels forward_labels_;
+    VertexLabels backward_labels_;
+
+    // рабочие буферы поиска: веса вершин (UNREACHABLE - не достигнута)
+    // и веса меток опорной вершины по рангам
+    std::vector<Value> weights_;
+    std::vector<VertexId> reached_;
+    std::vector<Value> hub_weights_;
+    std::vector<QueueItem> queue_;
+};
+
+template <typename Weight>
+HubLabels<Weight>::HubLabels(const Graph& graph) {
+    Builder builder(graph);
+    builder.Build(forward_labels_, backward_labels_);
+}
+
+template <typename Weight>
+HubLabels<Weight>::HubLabels(Labels forward_labels, Labels backward_labels)
+    : forward_labels_(std::move(forward_labels))
+    , backward_labels_(std::move(backward_labels))
+{
+    if (forward_labels_.offsets.size() != backward_labels_.offsets.size()) {
+        throw std::invalid_argument("Forward and backward labels must have the same vertex count");
+    }
+    CheckLabels(forward_labels_, GetVertexCount());
+    CheckLabels(backward_labels_, GetVertexCount());
+}
+
+template <typename Weight>
+void HubLabels<Weight>::CheckLabels(const Labels& labels, size_t vertex_count) {
+    if (labels.offsets.empty() || labels.offsets.front() != 0
+            || !std::is_sorted(labels.offsets.begin(), labels.offsets.end())
+            || labels.offsets.back() != labels.hubs.size() || labels.hubs.size() != labels.weights.size()) {
+        throw std::invalid_argument("Hub labels are inconsistent");
+    }
+    for (size_t vertex = 0; vertex < vertex_count; ++vertex) {
+        const auto begin = labels.hubs.begin() + static_cast<std::ptrdiff_t>(labels.offsets[vertex]);
+        const auto end = labels.hubs.begin() + static_cast<std::ptrdiff_t>(labels.offsets[vertex + 1]);
+        if (std::adjacent_find(begin, end, std::greater_equal<>{}) != end) {
+            throw std::invalid_argument("Hub labels must be sorted by hub rank");
+        }
+    }
+}
+
+template <typename Weight>
+std::optional<typename HubLabels<Weight>::Value>
+HubLabels<Weight>::ComputeRouteWeight(VertexId from, VertexId to) const {
+    if (from >= GetVertexCount() || to >= GetVertexCount()) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    size_t forward_index = forward_labels_.offsets[from];
+    const size_t forward_end = forward_labels_.offsets[from + 1];
+    size_t backward_index = backward_labels_.offsets[to];
+    const size_t backward_end = backward_labels_.offsets[to + 1];
+
+    Value result = UNREACHABLE;
+    while (forward_index < forward_end && backward_index < backward_end) {
+        const uint32_t forward_hub = forward_labels_.hubs[forward_index];
+        const uint32_t backward_hub = backward_labels_.hubs[backward_index];
+        if (forward_hub < backward_hub) {
+            ++forward_index;
+        } else if (backward_hub < forward_hub) {
+            ++backward_index;
+        } else {
+            result = std::min(result, forward_labels_.weights[forward_index++]
+                                      + backward_labels_.weights[backward_index++]);
+        }
+    }
+    if (result == UNREACHABLE) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+template <typename Weight>
+size_t HubLabels<Weight>::GetVertexCount() const {
+    return forward_labels_.offsets.empty() ? 0 : forward_labels_.offsets.size() - 1;
+}
+
+template <typename Weight>
+size_t HubLabels<Weight>::GetLabelCount() const {
+    return forward_labels_.hubs.size() + backward_labels_.hubs.size();
+}
+
+template <typename Weight>
+const typename HubLabels<Weight>::Labels& HubLabels<Weight>::GetForwardLabels() const {
+    return forward_labels_;
+}
+
+template <typename Weight>
+const typename HubLabels<Weight>::Labels& HubLabels<Weight>::GetBackwardLabels() const {
+    return backward_labels_;
+}
+
+}  // namespace graph
@@ -1,5 +1,6 @@
 #include "json_reader.h"
 
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -19,8 +20,9 @@ bool JsonLoader::LoadData(transport_catalogue::TransportCatalogue &catalogue) co
         // проверяем, что данные для загрузки хранятся в нужном формате
         if (base_requests.IsArray()) {
             LoadStops(base_requests.AsArray(), catalogue);
-            LoadBuses(base_requests.AsArray(), catalogue);
+            // расстояния до автобусов: пройденные расстояния автобуса считаются один раз при добавлении
             LoadDistances(base_requests.AsArray(), catalogue);
+            LoadBuses(base_requests.AsArray(), catalogue);
             return true;
         }
     }
@@ -45,8 +47,22 @@ void JsonLoader::AnswerRequests(const transport_catalogue::TransportCatalogue& c
         if (data_.GetRoot().IsMap() && data_.GetRoot().AsMap().count("stat_requests"s) > 0) {
         auto& requests = data_.GetRoot().AsMap().at("stat_requests"s);
         if (requests.IsArray()) {
-            json::Array answers = LoadAnswers(requests.AsArray(), catalogue, render_settings, router);
-            json::Print(json::Document(json::Node{ answers }), requests_out);
+            // ответы выводятся по мере готовности, как элементы одного массива
+            requests_out << "["s;
+            bool first_answer = true;
+            for (const auto& request : requests.AsArray()) {
+                if (IsMatrixRequest(request)) {
+                    requests_out << (first_answer ? ""s : ", "s);
+                    WriteMatrixAnswer(request.AsMap(), router, requests_out);
+                    first_answer = false;
+                }
+                else if (auto answer = LoadAnswer(request, catalogue, render_settings, router)) {
+                    requests_out << (first_answer ? ""s : ", "s);
+                    json::PrintNode(json::Node{ std::move(*answer) }, requests_out);
+                    first_answer = false;
+                }
+            }
+            requests_out << "]"s;
         }
     }
 }
@@ -159,32 +175,55 @@ std::optional<transport_router::TransportRouter::RoutingSettings>
             transport_router::TransportRouter::RoutingSettings result;
             result.wait_time = routing_settings.at("bus_wait_time"s).AsInt();
             result.velocity = routing_settings.at("bus_velocity"s).AsDouble() * transport_router::KMH_TO_MMIN;
+            if (routing_settings.count("engine"s) && routing_settings.at("engine"s).IsString()) {
+                result.engine = ReadRoutingEngine(routing_settings.at("engine"s).AsString());
+            }
+            if (routing_settings.count("graph_model"s) && routing_settings.at("graph_model"s).IsString()) {
+                result.graph_model = ReadGraphModel(routing_settings.at("graph_model"s).AsString());
+            }
+            if (routing_settings.count("route_cache_size"s) && routing_settings.at("route_cache_size"s).IsInt()) {
+                result.route_cache_size = static_cast<size_t>(
+                        std::max(routing_settings.at("route_cache_size"s).AsInt(), 0));
+            }
+            if (routing_settings.count("lazy_row_limit"s) && routing_settings.at("lazy_row_limit"s).IsInt()) {
+                result.lazy_row_limit = static_cast<size_t>(
+                        std::max(routing_settings.at("lazy_row_limit"s).AsInt(), 1));
+            }
+            if (routing_settings.count("all_pairs_algorithm"s) && routing_settings.at("all_pairs_algorithm"s).IsString()) {
+                result.all_pairs_algorithm = ReadAllPairsAlgorithm(routing_settings.at("all_pairs_algorithm"s).AsString());
+            }
+            if (routing_settings.count("hub_labels"s) && routing_settings.at("hub_labels"s).IsBool()) {
+                result.hub_labels = routing_settings.at("hub_labels"s).AsBool();
+            }
+            if (routing_settings.count("compress_chains"s) && routing_settings.at("compress_chains"s).IsBool()) {
+                result.compress_chains = routing_settings.at("compress_chains"s).AsBool();
+            }
             return result;
         }
     }
     return std::nullopt;
 }
 
-json::Array JsonLoader::LoadAnswers(const json::Array& requests,
+std::optional<json::Dict> JsonLoader::LoadAnswer(const json::Node& request,
     const transport_catalogue::TransportCatalogue& catalogue,
     const renderer::RenderSettings& render_settings,
     transport_router::TransportRouter& router) const {
-    json::Array result;
-    for (const auto& request : requests) {
-        if (IsRouteRequest(request)) {
-            result.push_back(LoadRouteAnswer(request.AsMap(), catalogue));
-        }
-        else if (IsStopRequest(request)) {
-            result.push_back(LoadStopAnswer(request.AsMap(), catalogue));
-        }
-        else if (IsMapRequest(request)) {
-            result.push_back(LoadMapAnswer(request.AsMap(), catalogue, render_settings));
-        }
-        else if (IsRouteBuildRequest(request)) {
-            result.push_back(LoadRouteBuildAnswer(request.AsMap(), catalogue, router));
-        }
+    if (IsRouteRequest(request)) {
+        return LoadRouteAnswer(request.AsMap(), catalogue);
     }
-    return result;
+    else if (IsStopRequest(request)) {
+        return LoadStopAnswer(request.AsMap(), catalogue);
+    }
+    else if (IsMapRequest(request)) {
+        return LoadMapAnswer(request.AsMap(), catalogue, render_settings);
+    }
+    else if (IsRouteBuildRequest(request)) {
+        return LoadRouteBuildAnswer(request.AsMap(), catalogue, router);
+    }
+    else if (IsIsochroneRequest(request)) {
+        return LoadIsochroneAnswer(request.AsMap(), router);
+    }
+    return std::nullopt;
 }
 
 json::Dict JsonLoader::LoadRouteAnswer(const json::Dict& request,
@@ -229,15 +268,40 @@ json::Dict JsonLoader::LoadRouteBuildAnswer(const json::Dict& request,
     const auto& from = request.at("from"s).AsString();
     const auto& to = request.at("to"s).AsString();
 
+    // alternatives: k - вернуть ещё до k маршрутов с другой последовательностью автобусов
+    size_t alternative_count = 0;
+    if (request.count("alternatives"s) && request.at("alternatives"s).IsInt()) {
+        alternative_count = static_cast<size_t>(std::max(request.at("alternatives"s).AsInt(), 0));
+    }
+    if (alternative_count > 0) {
+        auto routes = router.BuildRoutes(from, to, alternative_count + 1);
+        if (routes.empty()) {
+            return ErrorMessage(id);
+        }
+        json::Array alternatives;
+        for (size_t i = 1; i < routes.size(); ++i) {
+            alternatives.push_back(LoadRouteItems(routes[i], router.GetSettings().wait_time));
+        }
+        json::Dict result = LoadRouteItems(routes.front(), router.GetSettings().wait_time);
+        result.emplace("request_id"s, id);
+        result.emplace("alternatives"s, std::move(alternatives));
+        return result;
+    }
+
     auto route = router.BuildRoute(from, to);
     if (!route.has_value()) {
         return ErrorMessage(id);
     }
+    json::Dict result = LoadRouteItems(route.value(), router.GetSettings().wait_time);
+    result.emplace("request_id"s, id);
+    return result;
+}
 
+json::Dict JsonLoader::LoadRouteItems(const transport_router::TransportRouter::TransportRoute& route,
+    int wait_time) {
     double total_time = 0;
-    int wait_time = router.GetSettings().wait_time;
     json::Array items;
-    for (const auto& edge : route.value()) {
+    for (const auto& edge : route) {
         total_time += edge.total_time;
         json::Dict wait_elem = json::Builder{}.StartDict().
             Key("type"s).Value("Wait"s).
@@ -254,12 +318,85 @@ json::Dict JsonLoader::LoadRouteBuildAnswer(const json::Dict& request,
         items.push_back(ride_elem);
     }
     return json::Builder{}.StartDict().
-        Key("request_id"s).Value(id).
         Key("total_time"s).Value(total_time).
         Key("items"s).Value(items).
         EndDict().Build().AsMap();
 }
 
+json::Dict JsonLoader::LoadIsochroneAnswer(const json::Dict& request,
+    const transport_router::TransportRouter& router) const {
+    int id = request.at("id"s).AsInt();
+    const auto& from = request.at("from"s).AsString();
+    const double max_time = request.at("max_time"s).AsDouble();
+
+    transport_router::TransportRouter::Isochrone isochrone;
+    try {
+        isochrone = router.BuildIsochrone(from, max_time);
+    }
+    catch (std::out_of_range&) {
+        return ErrorMessage(id);
+    }
+
+    json::Array stops;
+    stops.reserve(isochrone.size());
+    for (const auto& stop_time : isochrone) {
+        stops.push_back(json::Builder{}.StartDict().
+            Key("stop_name"s).Value(std::string(stop_time.stop_name)).
+            Key("time"s).Value(stop_time.time).
+            EndDict().Build());
+    }
+    return json::Builder{}.StartDict().
+        Key("request_id"s).Value(id).
+        Key("stops"s).Value(stops).
+        EndDict().Build().AsMap();
+}
+
+void JsonLoader::WriteMatrixAnswer(const json::Dict& request,
+    const transport_router::TransportRouter& router,
+    std::ostream& out) {
+    int id = request.at("id"s).AsInt();
+    const auto origins = ReadStringArray(request.at("from"s).AsArray());
+    const auto destinations = ReadStringArray(request.at("to"s).AsArray());
+
+    // формат совпадает с выводом json::Dict {"request_id", "times"}
+    auto write_header = [&] {
+        out << "{"s << std::endl << "\"request_id\": "s << id << ", "s << std::endl << "\"times\": ["s;
+    };
+    try {
+        // неизвестные остановки проверяются до первой строки, так что заголовок пишется с ней
+        router.BuildTravelTimeMatrix(origins, destinations,
+            [&](size_t origin_index, const transport_router::TransportRouter::TravelTimes& times) {
+                if (origin_index == 0) {
+                    write_header();
+                }
+                else {
+                    out << ", "s;
+                }
+                out << "["s;
+                for (size_t i = 0; i < times.size(); ++i) {
+                    if (i > 0) {
+                        out << ", "s;
+                    }
+                    if (times[i]) {
+                        out << *times[i];
+                    }
+                    else {
+                        out << "null"s;
+                    }
+                }
+                out << "]"s;
+            });
+    }
+    catch (std::out_of_range&) {
+        json::PrintNode(json::Node{ ErrorMessage(id) }, out);
+        return;
+    }
+    if (origins.empty()) {
+        write_header();
+    }
+    out << "]"s << std::endl << "}"s;
+}
+
 json::Dict JsonLoader::ErrorMessage(int id) {
     return json::Builder{}.StartDict().
         Key("request_id"s).Value(id).
@@ -379,6 +516,67 @@ bool JsonLoader::IsRouteBuildRequest(const json::Node& node) {
     return true;
 }
 
+bool JsonLoader::IsMatrixRequest(const json::Node& node) {
+    if (!node.IsMap()) {
+        return false;
+    }
+    const auto& request = node.AsMap();
+    if (request.count("type"s) == 0 || request.at("type"s) != "Matrix"s) {
+        return false;
+    }
+    if (request.count("id"s) == 0 || !(request.at("id"s).IsInt())) {
+        return false;
+    }
+    if (request.count("from") == 0 || !IsStringArray(request.at("from"))) {
+        return false;
+    }
+    if (request.count("to") == 0 || !IsStringArray(request.at("to"))) {
+        return false;
+    }
+    return true;
+}
+
+bool JsonLoader::IsIsochroneRequest(const json::Node& node) {
+    if (!node.IsMap()) {
+        return false;
+    }
+    const auto& request = node.AsMap();
+    if (request.count("type"s) == 0 || request.at("type"s) != "Isochrone"s) {
+        return false;
+    }
+    if (request.count("id"s) == 0 || !(request.at("id"s).IsInt())) {
+        return false;
+    }
+    if (request.count("from") == 0 || !request.at("from").IsString()) {
+        return false;
+    }
+    if (request.count("max_time") == 0 || !request.at("max_time").IsDouble()) {
+        return false;
+    }
+    return true;
+}
+
+bool JsonLoader::IsStringArray(const json::Node& node) {
+    if (!node.IsArray()) {
+        return false;
+    }
+    for (const auto& elem : node.AsArray()) {
+        if (!elem.IsString()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> JsonLoader::ReadStringArray(const json::Array& node) {
+    std::vector<std::string> result;
+    result.reserve(node.size());
+    for (const auto& elem : node) {
+        result.push_back(elem.AsString());
+    }
+    return result;
+}
+
 svg::Color JsonLoader::ReadColor(const json::Node& color) {
     if (color.IsString()) {
         return color.AsString();
@@ -401,6 +599,51 @@ svg::Color JsonLoader::ReadColor(const json::Node& color) {
     }
 }
 
+transport_router::TransportRouter::Engine JsonLoader::ReadRoutingEngine(const std::string& engine) {
+    using Engine = transport_router::TransportRouter::Engine;
+    if (engine == "dijkstra"s) {
+        return Engine::DIJKSTRA;
+    }
+    if (engine == "contraction_hierarchy"s) {
+        return Engine::CONTRACTION_HIERARCHY;
+    }
+    if (engine == "a_star"s) {
+        return Engine::A_STAR;
+    }
+    if (engine == "raptor"s) {
+        return Engine::RAPTOR;
+    }
+    if (engine == "lazy_rows"s) {
+        return Engine::LAZY_ROWS;
+    }
+    if (engine != "all_pairs"s) {
+        std::cerr << "Unknown routing engine : "s << engine << ", all_pairs is used"s << std::endl;
+    }
+    return Engine::ALL_PAIRS;
+}
+
+transport_router::TransportRouter::GraphModel JsonLoader::ReadGraphModel(const std::string& graph_model) {
+    using GraphModel = transport_router::TransportRouter::GraphModel;
+    if (graph_model == "on_board"s) {
+        return GraphModel::ON_BOARD;
+    }
+    if (graph_model != "stop_pairs"s) {
+        std::cerr << "Unknown graph model : "s << graph_model << ", stop_pairs is used"s << std::endl;
+    }
+    return GraphModel::STOP_PAIRS;
+}
+
+transport_router::TransportRouter::Router::Algorithm JsonLoader::ReadAllPairsAlgorithm(const std::string& algorithm) {
+    using Algorithm = transport_router::TransportRouter::Router::Algorithm;
+    if (algorithm == "dijkstra"s) {
+        return Algorithm::DIJKSTRA;
+    }
+    if (algorithm != "floyd_warshall"s) {
+        std::cerr << "Unknown all pairs algorithm : "s << algorithm << ", floyd_warshall is used"s << std::endl;
+    }
+    return Algorithm::BLOCKED;
+}
+
 svg::Point JsonLoader::ReadOffset(const json::Array& offset) {
     svg::Point result;
     if (offset.size() > 1) {
@@ -9,6 +9,8 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace json_reader {
 
@@ -35,11 +37,11 @@ private:
     // Устанавливает настройки рендера
     renderer::RenderSettings LoadSettings(const json::Dict &data) const;
 
-    // формирует и возвращает ответы на запросы
-    json::Array LoadAnswers(const json::Array &requests,
-                            const transport_catalogue::TransportCatalogue &catalogue,
-                            const renderer::RenderSettings &render_settings,
-                            transport_router::TransportRouter &router) const;
+    // формирует и возвращает ответ на запрос, nullopt - запрос некорректен
+    std::optional<json::Dict> LoadAnswer(const json::Node &request,
+                                         const transport_catalogue::TransportCatalogue &catalogue,
+                                         const renderer::RenderSettings &render_settings,
+                                         transport_router::TransportRouter &router) const;
 
     // загрузка данных из json в каталог
     static void LoadStops(const json::Array &data, transport_catalogue::TransportCatalogue &catalogue);
@@ -58,6 +60,18 @@ private:
     json::Dict LoadRouteBuildAnswer(const json::Dict &request,
                                     const transport_catalogue::TransportCatalogue &catalogue,
                                     transport_router::TransportRouter &router) const;
+    // время и элементы маршрута (ожидания и поездки)
+    static json::Dict LoadRouteItems(const transport_router::TransportRouter::TransportRoute &route,
+                                     int wait_time);
+
+    json::Dict LoadIsochroneAnswer(const json::Dict &request,
+                                   const transport_router::TransportRouter &router) const;
+
+    // ответ на запрос матрицы времени в пути записывается в поток по строкам,
+    // не собирая всю матрицу в json::Array
+    static void WriteMatrixAnswer(const json::Dict &request,
+                                  const transport_router::TransportRouter &router,
+                                  std::ostream &out);
 
     // возвращает сообщение с ошибкой о запросе с некорректным именем автобуса или маршрута
     static json::Dict ErrorMessage(int id);
@@ -69,9 +83,16 @@ private:
     static bool IsStopRequest(const json::Node &node);
     static bool IsMapRequest(const json::Node &node);
     static bool IsRouteBuildRequest(const json::Node &node);
+    static bool IsMatrixRequest(const json::Node &node);
+    static bool IsIsochroneRequest(const json::Node &node);
+    static bool IsStringArray(const json::Node &node);
+    static std::vector<std::string> ReadStringArray(const json::Array &node);
 
     static svg::Color ReadColor(const json::Node &node);
     static svg::Point ReadOffset(const json::Array &node);
+    static transport_router::TransportRouter::Engine ReadRoutingEngine(const std::string &engine);
+    static transport_router::TransportRouter::GraphModel ReadGraphModel(const std::string &graph_model);
+    static transport_router::TransportRouter::Router::Algorithm ReadAllPairsAlgorithm(const std::string &algorithm);
 
     json::Document data_;
 };
@@ -0,0 +1,391 @@
+#pragma once
+
+#include "graph.h"
+#include "router.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// Поиск нескольких кратчайших простых путей алгоритмом Йена.
+// Каждый найденный путь порождает кандидатов-отклонений: для каждой его вершины ищется путь
+// до цели в обход уже использованных из неё рёбер и вершин общего начала пути.
+// На запрос один раз строится дерево кратчайших путей до цели по входящим рёбрам:
+// расстояние до цели по нему - точная для графа без запретов оценка A* в поисках отклонений,
+// а поиск завершается на первой вершине, путь которой по дереву обходит запреты.
+// Кандидаты от всех путей хранятся в общей куче, повторяющиеся пути отсеиваются.
+// Рабочие буферы поисков (Scratch) передаёт вызывающий, сам объект после построения не меняется:
+// запросы с разными Scratch можно выполнять из нескольких потоков одновременно.
+template <typename Weight>
+class KShortestPaths {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+public:
+    using RouteInfo = typename Router<Weight>::RouteInfo;
+
+    struct QueueItem {
+        Weight weight;
+        VertexId vertex;
+    };
+
+    // рабочие буферы одного потока, метки работают как в DijkstraRouter.
+    // Размеры подстраиваются под граф при первом запросе
+    struct Scratch {
+        std::vector<Weight> weights;
+        std::vector<EdgeId> prev_edges;
+        std::vector<uint32_t> search_marks;
+        uint32_t search_mark = 0;
+        std::vector<QueueItem> queue;
+        // дерево кратчайших путей до цели: вес и первое ребро пути из вершины
+        std::vector<Weight> tree_weights;
+        std::vector<EdgeId> tree_next_edges;
+        std::vector<uint32_t> tree_marks;
+        uint32_t tree_mark = 0;
+        // проверенные в текущем поиске пути по дереву (метка поиска) и их проходимость
+        std::vector<uint32_t> tree_path_marks;
+        std::vector<uint8_t> tree_path_free;
+        std::vector<VertexId> tree_path;
+        // запреты текущего отклонения
+        std::vector<uint32_t> banned_vertex_marks;
+        std::vector<uint32_t> banned_edge_marks;
+        uint32_t ban_mark = 0;
+    };
+
+    // верхняя граница просмотренных путей на один возвращаемый
+    static constexpr size_t PATHS_PER_ROUTE_LIMIT = 16;
+
+    explicit KShortestPaths(const Graph& graph);
+
+    // До max_route_count путей из from в to по возрастанию веса.
+    // accept(route) решает, попадёт ли путь в результат (например, отсев похожих путей);
+    // отвергнутые пути всё равно порождают следующих кандидатов.
+    // Перебор ограничен max_route_count * PATHS_PER_ROUTE_LIMIT путями
+    template <typename Accept>
+    std::vector<RouteInfo> BuildRoutes(VertexId from, VertexId to, size_t max_route_count, Accept&& accept,
+                                       Scratch& scratch) const;
+
+private:
+    struct Candidate {
+        Weight weight;
+        size_t order = 0;   // порядок добавления, для воспроизводимости при равных весах
+        std::vector<EdgeId> edges;
+    };
+
+    // поиск Дейкстры из to по входящим рёбрам, дерево остаётся в scratch.tree_*
+    void BuildTree(VertexId to, Scratch& scratch) const;
+    // поиск A* в обход запрещённых вершин и рёбер. Возвращает вершину, с которой путь
+    // продолжается по дереву; начало пути остаётся в scratch.prev_edges
+    std::optional<VertexId> SearchSpur(VertexId from, Scratch& scratch) const;
+    // проходит ли путь из vertex по дереву в обход запретов, ответ запоминается до следующего поиска
+    bool IsTreePathFree(VertexId vertex, Scratch& scratch) const;
+    // добавляет к root путь до цели через вершину last, найденную SearchSpur
+    void AppendSpur(VertexId last, const Scratch& scratch, std::vector<EdgeId>& root) const;
+    Weight ComputeWeight(const std::vector<EdgeId>& edges) const;
+    // подгоняет буферы под граф
+    void PrepareScratch(Scratch& scratch) const;
+    // начинает новый набор запретов без обнуления меток
+    static void StartBans(Scratch& scratch);
+
+    static bool QueueCompare(const QueueItem& lhs, const QueueItem& rhs) {
+        return lhs.weight > rhs.weight;
+    }
+    static bool CandidateCompare(const Candidate& lhs, const Candidate& rhs) {
+        if (lhs.weight < rhs.weight || rhs.weight < lhs.weight) {
+            return rhs.weight < lhs.weight;
+        }
+        return lhs.order > rhs.order;
+    }
+
+    static constexpr Weight ZERO_WEIGHT{};
+    static constexpr EdgeId NO_EDGE = std::numeric_limits<EdgeId>::max();
+
+    const Graph& graph_;
+    // входящие рёбра вершины v: reverse_edge_ids_[reverse_offsets_[v]..reverse_offsets_[v + 1])
+    std::vector<size_t> reverse_offsets_;
+    std::vector<EdgeId> reverse_edge_ids_;
+};
+
+template <typename Weight>
+KShortestPaths<Weight>::KShortestPaths(const Graph& graph)
+    : graph_(graph)
+    , reverse_offsets_(graph.GetVertexCount() + 1, 0)
+{
+    const auto& edges = graph.GetEdges();
+    for (const auto& edge : edges) {
+        if (edge.weight < ZERO_WEIGHT) {
+            throw std::domain_error("Edges' weights should be non-negative");
+        }
+        ++reverse_offsets_[edge.to + 1];
+    }
+    for (size_t vertex = 0; vertex < graph.GetVertexCount(); ++vertex) {
+        reverse_offsets_[vertex + 1] += reverse_offsets_[vertex];
+    }
+    reverse_edge_ids_.resize(edges.size());
+    std::vector<size_t> positions(reverse_offsets_.begin(), reverse_offsets_.end() - 1);
+    for (EdgeId edge_id = 0; edge_id < edges.size(); ++edge_id) {
+        reverse_edge_ids_[positions[edges[edge_id].to]++] = edge_id;
+    }
+}
+
+template <typename Weight>
+template <typename Accept>
+std::vector<typename KShortestPaths<Weight>::RouteInfo>
+KShortestPaths<Weight>::BuildRoutes(VertexId from, VertexId to, size_t max_route_count, Accept&& accept,
+                                    Scratch& scratch) const {
+    if (from >= graph_.GetVertexCount() || to >= graph_.GetVertexCount()) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    std::vector<RouteInfo> result;
+    if (max_route_count == 0) {
+        return result;
+    }
+
+    PrepareScratch(scratch);
+    BuildTree(to, scratch);
+    StartBans(scratch);
+    const auto first_last = SearchSpur(from, scratch);
+    if (!first_last) {
+        return result;
+    }
+    std::vector<Candidate> candidates;
+    std::set<std::vector<EdgeId>> seen_paths;
+    {
+        Candidate first;
+        AppendSpur(*first_last, scratch, first.edges);
+        first.weight = ComputeWeight(first.edges);
+        seen_paths.insert(first.edges);
+        candidates.push_back(std::move(first));
+    }
+    size_t candidate_order = 1;
+
+    std::vector<std::vector<EdgeId>> found_paths;
+    std::vector<VertexId> path_vertices;
+    const size_t max_path_count = max_route_count * PATHS_PER_ROUTE_LIMIT;
+    while (!candidates.empty() && result.size() < max_route_count && found_paths.size() < max_path_count) {
+        std::pop_heap(candidates.begin(), candidates.end(), CandidateCompare);
+        Candidate path = std::move(candidates.back());
+        candidates.pop_back();
+
+        RouteInfo route{path.weight, path.edges};
+        if (accept(static_cast<const RouteInfo&>(route))) {
+            result.push_back(std::move(route));
+            if (result.size() == max_route_count) {
+                break;
+            }
+        }
+        found_paths.push_back(std::move(path.edges));
+        const auto& edges = found_paths.back();
+
+        path_vertices.assign(1, from);
+        for (const EdgeId edge_id : edges) {
+            path_vertices.push_back(graph_.GetEdge(edge_id).to);
+        }
+        // отклонение в каждой вершине пути: начало пути сохраняется, дальше - в обход
+        for (size_t spur_index = 0; spur_index < edges.size(); ++spur_index) {
+            StartBans(scratch);
+            for (size_t i = 0; i < spur_index; ++i) {
+                scratch.banned_vertex_marks[path_vertices[i]] = scratch.ban_mark;
+            }
+            for (const auto& found_path : found_paths) {
+                if (found_path.size() > spur_index
+                        && std::equal(edges.begin(), edges.begin() + static_cast<std::ptrdiff_t>(spur_index),
+                                      found_path.begin())) {
+                    scratch.banned_edge_marks[found_path[spur_index]] = scratch.ban_mark;
+                }
+            }
+            const auto last = SearchSpur(path_vertices[spur_index], scratch);
+            if (!last) {
+                continue;
+            }
+            Candidate candidate;
+            candidate.edges.assign(edges.begin(), edges.begin() + static_cast<std::ptrdiff_t>(spur_index));
+            AppendSpur(*last, scratch, candidate.edges);
+            if (!seen_paths.insert(candidate.edges).second) {
+                continue;
+            }
+            candidate.weight = ComputeWeight(candidate.edges);
+            candidate.order = candidate_order++;
+            candidates.push_back(std::move(candidate));
+            std::push_heap(candidates.begin(), candidates.end(), CandidateCompare);
+        }
+    }
+    return result;
+}
+
+template <typename Weight>
+void KShortestPaths<Weight>::BuildTree(VertexId to, Scratch& scratch) const {
+    scratch.queue.clear();
+    if (++scratch.tree_mark == 0) {
+        std::fill(scratch.tree_marks.begin(), scratch.tree_marks.end(), 0);
+        scratch.tree_mark = 1;
+    }
+    scratch.tree_weights[to] = ZERO_WEIGHT;
+    scratch.tree_next_edges[to] = NO_EDGE;
+    scratch.tree_marks[to] = scratch.tree_mark;
+    scratch.queue.push_back({ZERO_WEIGHT, to});
+
+    while (!scratch.queue.empty()) {
+        std::pop_heap(scratch.queue.begin(), scratch.queue.end(), QueueCompare);
+        const QueueItem item = scratch.queue.back();
+        scratch.queue.pop_back();
+        if (scratch.tree_weights[item.vertex] < item.weight) {
+            continue;
+        }
+        for (size_t index = reverse_offsets_[item.vertex]; index < reverse_offsets_[item.vertex + 1]; ++index) {
+            const auto& edge = graph_.GetEdge(reverse_edge_ids_[index]);
+            const Weight candidate_weight = item.weight + edge.weight;
+            if (scratch.tree_marks[edge.from] != scratch.tree_mark
+                    || candidate_weight < scratch.tree_weights[edge.from]) {
+                scratch.tree_weights[edge.from] = candidate_weight;
+                scratch.tree_next_edges[edge.from] = reverse_edge_ids_[index];
+                scratch.tree_marks[edge.from] = scratch.tree_mark;
+                scratch.queue.push_back({candidate_weight, edge.from});
+                std::push_heap(scratch.queue.begin(), scratch.queue.end(), QueueCompare);
+            }
+        }
+    }
+}
+
+template <typename Weight>
+std::optional<VertexId> KShortestPaths<Weight>::SearchSpur(VertexId from, Scratch& scratch) const {
+    // из вершины вне дерева цель недостижима даже без запретов
+    if (scratch.tree_marks[from] != scratch.tree_mark) {
+        return std::nullopt;
+    }
+    scratch.queue.clear();
+    if (++scratch.search_mark == 0) {
+        std::fill(scratch.search_marks.begin(), scratch.search_marks.end(), 0);
+        std::fill(scratch.tree_path_marks.begin(), scratch.tree_path_marks.end(), 0);
+        scratch.search_mark = 1;
+    }
+    scratch.weights[from] = ZERO_WEIGHT;
+    scratch.prev_edges[from] = NO_EDGE;
+    scratch.search_marks[from] = scratch.search_mark;
+    scratch.queue.push_back({scratch.tree_weights[from], from});
+
+    while (!scratch.queue.empty()) {
+        std::pop_heap(scratch.queue.begin(), scratch.queue.end(), QueueCompare);
+        const QueueItem item = scratch.queue.back();
+        scratch.queue.pop_back();
+        const Weight weight = scratch.weights[item.vertex];
+        if (weight + scratch.tree_weights[item.vertex] < item.weight) {
+            continue;
+        }
+        // оценка точна: путь по дереву без запретов не тяжелее любого оставшегося в очереди
+        if (IsTreePathFree(item.vertex, scratch)) {
+            return item.vertex;
+        }
+        for (const auto& edge : graph_.GetOutgoingEdges(item.vertex)) {
+            if (scratch.banned_edge_marks[edge.id] == scratch.ban_mark
+                    || scratch.banned_vertex_marks[edge.to] == scratch.ban_mark
+                    || scratch.tree_marks[edge.to] != scratch.tree_mark) {
+                continue;
+            }
+            const Weight candidate_weight = weight + edge.weight;
+            if (scratch.search_marks[edge.to] != scratch.search_mark || candidate_weight < scratch.weights[edge.to]) {
+                scratch.weights[edge.to] = candidate_weight;
+                scratch.prev_edges[edge.to] = edge.id;
+                scratch.search_marks[edge.to] = scratch.search_mark;
+                scratch.queue.push_back({candidate_weight + scratch.tree_weights[edge.to], edge.to});
+                std::push_heap(scratch.queue.begin(), scratch.queue.end(), QueueCompare);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+template <typename Weight>
+bool KShortestPaths<Weight>::IsTreePathFree(VertexId vertex, Scratch& scratch) const {
+    // проходим путь до вершины с известным ответом; он же - ответ для всех пройденных вершин
+    scratch.tree_path.clear();
+    bool is_free = true;
+    while (true) {
+        if (scratch.tree_path_marks[vertex] == scratch.search_mark) {
+            is_free = scratch.tree_path_free[vertex] != 0;
+            break;
+        }
+        scratch.tree_path.push_back(vertex);
+        if (scratch.banned_vertex_marks[vertex] == scratch.ban_mark) {
+            is_free = false;
+            break;
+        }
+        const EdgeId edge_id = scratch.tree_next_edges[vertex];
+        if (edge_id == NO_EDGE) {
+            break;
+        }
+        if (scratch.banned_edge_marks[edge_id] == scratch.ban_mark) {
+            is_free = false;
+            break;
+        }
+        vertex = graph_.GetEdge(edge_id).to;
+    }
+    for (const VertexId path_vertex : scratch.tree_path) {
+        scratch.tree_path_marks[path_vertex] = scratch.search_mark;
+        scratch.tree_path_free[path_vertex] = is_free ? 1 : 0;
+    }
+    return is_free;
+}
+
+template <typename Weight>
+void KShortestPaths<Weight>::AppendSpur(VertexId last, const Scratch& scratch, std::vector<EdgeId>& root) const {
+    const size_t root_size = root.size();
+    for (EdgeId edge_id = scratch.prev_edges[last]; edge_id != NO_EDGE;
+         edge_id = scratch.prev_edges[graph_.GetEdge(edge_id).from]) {
+        root.push_back(edge_id);
+    }
+    std::reverse(root.begin() + static_cast<std::ptrdiff_t>(root_size), root.end());
+    for (EdgeId edge_id = scratch.tree_next_edges[last]; edge_id != NO_EDGE;
+         edge_id = scratch.tree_next_edges[graph_.GetEdge(edge_id).to]) {
+        root.push_back(edge_id);
+    }
+}
+
+template <typename Weight>
+Weight KShortestPaths<Weight>::ComputeWeight(const std::vector<EdgeId>& edges) const {
+    Weight result = ZERO_WEIGHT;
+    for (const EdgeId edge_id : edges) {
+        result = result + graph_.GetEdge(edge_id).weight;
+    }
+    return result;
+}
+
+template <typename Weight>
+void KShortestPaths<Weight>::PrepareScratch(Scratch& scratch) const {
+    const size_t vertex_count = graph_.GetVertexCount();
+    const size_t edge_count = graph_.GetEdgeCount();
+    if (scratch.search_marks.size() != vertex_count || scratch.banned_edge_marks.size() != edge_count) {
+        // буфер новый или остался от другого графа
+        scratch.weights.resize(vertex_count);
+        scratch.prev_edges.assign(vertex_count, NO_EDGE);
+        scratch.search_marks.assign(vertex_count, 0);
+        scratch.search_mark = 0;
+        scratch.tree_weights.resize(vertex_count);
+        scratch.tree_next_edges.assign(vertex_count, NO_EDGE);
+        scratch.tree_marks.assign(vertex_count, 0);
+        scratch.tree_mark = 0;
+        scratch.tree_path_marks.assign(vertex_count, 0);
+        scratch.tree_path_free.assign(vertex_count, 0);
+        scratch.banned_vertex_marks.assign(vertex_count, 0);
+        scratch.banned_edge_marks.assign(edge_count, 0);
+        scratch.ban_mark = 0;
+    }
+}
+
+template <typename Weight>
+void KShortestPaths<Weight>::StartBans(Scratch& scratch) {
+    if (++scratch.ban_mark == 0) {
+        std::fill(scratch.banned_vertex_marks.begin(), scratch.banned_vertex_marks.end(), 0);
+        std::fill(scratch.banned_edge_marks.begin(), scratch.banned_edge_marks.end(), 0);
+        scratch.ban_mark = 1;
+    }
+}
+
+}  // namespace graph
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "graph.h"
+#include "router.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// Маршрутизатор, вычисляющий строки таблицы маршрутов по требованию.
+// При первом запросе из вершины from выполняется поиск Дейкстры по всему графу,
+// строка (веса и последние рёбра маршрутов) запоминается и обслуживает следующие запросы из from.
+// Хранится не больше max_row_count строк (по V * (sizeof(Value) + sizeof(EdgeId)) байт каждая),
+// при переполнении вытесняется давно не использованная строка.
+// Кэш строк общий и защищён мьютексом, но под ним выполняются только поиск и вставка строки:
+// сама строка вычисляется в буфер потока без блокировки, а читается по общему указателю,
+// поэтому вытеснение не мешает запросам, которые её ещё используют.
+// Запросы из разных потоков безопасны и выполняются одновременно.
+template <typename Weight>
+class LazyRouter {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+    using Value = typename WeightTraits<Weight>::Value;
+
+public:
+    using RouteInfo = typename Router<Weight>::RouteInfo;
+
+    LazyRouter(const Graph& graph, size_t max_row_count);
+
+    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+    // маршрут в память вызывающего: edges очищается и заполняется рёбрами от первого к последнему
+    std::optional<Weight> BuildRoute(VertexId from, VertexId to, std::vector<EdgeId>& edges) const;
+
+    size_t GetRowCount() const;
+    size_t GetMaxRowCount() const;
+    // число строк, вычисленных поиском (включая вытесненные и вычисленные заново)
+    size_t GetComputedRowCount() const;
+
+private:
+    struct Row {
+        VertexId from = 0;
+        std::vector<Value> weights;
+        std::vector<EdgeId> prev_edges;
+    };
+    using Rows = std::list<std::shared_ptr<Row>>;
+
+    struct QueueItem {
+        Value weight;
+        VertexId vertex;
+    };
+
+    // буферы вычисления строки в текущем потоке
+    struct RowScratch {
+        // строка для следующего вычисления, остаётся в потоке, если её успел вычислить другой
+        std::shared_ptr<Row> row;
+        std::vector<QueueItem> queue;
+    };
+
+    // возвращает строку для from, вычисляя её при необходимости
+    std::shared_ptr<const Row> GetRow(VertexId from) const;
+    // ищет строку в кэше и делает её самой свежей, вызывается под мьютексом
+    std::shared_ptr<const Row> FindRow(VertexId from) const;
+    void ComputeRow(Row& row, std::vector<QueueItem>& queue) const;
+    static RowScratch& GetThreadScratch();
+
+    static bool QueueCompare(const QueueItem& lhs, const QueueItem& rhs) {
+        return lhs.weight > rhs.weight;
+    }
+
+    static constexpr Value UNREACHABLE = std::numeric_limits<Value>::infinity();
+    static constexpr EdgeId NO_EDGE = std::numeric_limits<EdgeId>::max();
+
+    const Graph& graph_;
+    const size_t max_row_count_;
+
+    // строки от самой свежей к самой старой
+    mutable Rows rows_;
+    mutable std::unordered_map<VertexId, typename Rows::iterator> rows_by_vertex_;
+    mutable size_t computed_row_count_ = 0;
+    mutable std::mutex mutex_;
+};
+
+template <typename Weight>
+LazyRouter<Weight>::LazyRouter(const Graph& graph, size_t max_row_count)
+    : graph_(graph)
+    , max_row_count_(std::max<size_t>(max_row_count, 1))
+{
+    for (const auto& edge : graph.GetEdges()) {
+        if (edge.weight < Weight{}) {
+            throw std::domain_error("Edges' weights should be non-negative");
+        }
+    }
+}
+
+template <typename Weight>
+std::optional<typename LazyRouter<Weight>::RouteInfo>
+LazyRouter<Weight>::BuildRoute(VertexId from, VertexId to) const {
+    std::vector<EdgeId> edges;
+    auto weight = BuildRoute(from, to, edges);
+    if (!weight) {
+        return std::nullopt;
+    }
+    return RouteInfo{*weight, std::move(edges)};
+}
+
+template <typename Weight>
+std::optional<Weight> LazyRouter<Weight>::BuildRoute(VertexId from, VertexId to, std::vector<EdgeId>& edges) const {
+    if (from >= graph_.GetVertexCount() || to >= graph_.GetVertexCount()) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    edges.clear();
+    const auto row_ptr = GetRow(from);
+    const Row& row = *row_ptr;
+    if (row.weights[to] == UNREACHABLE) {
+        return std::nullopt;
+    }
+
+    for (EdgeId edge_id = row.prev_edges[to]; edge_id != NO_EDGE;
+         edge_id = row.prev_edges[graph_.GetEdge(edge_id).from]) {
+        edges.push_back(edge_id);
+    }
+    std::reverse(edges.begin(), edges.end());
+    return WeightTraits<Weight>::FromValue(row.weights[to]);
+}
+
+template <typename Weight>
+size_t LazyRouter<Weight>::GetRowCount() const {
+    std::lock_guard lock(mutex_);
+    return rows_.size();
+}
+
+template <typename Weight>
+size_t LazyRouter<Weight>::GetMaxRowCount() const {
+    return max_row_count_;
+}
+
+template <typename Weight>
+size_t LazyRouter<Weight>::GetComputedRowCount() const {
+    std::lock_guard lock(mutex_);
+    return computed_row_count_;
+}
+
+template <typename Weight>
+std::shared_ptr<const typename LazyRouter<Weight>::Row> LazyRouter<Weight>::GetRow(VertexId from) const {
+    {
+        std::lock_guard lock(mutex_);
+        if (auto row = FindRow(from)) {
+            return row;
+        }
+    }
+
+    // строка считается без блокировки: запросы из других вершин не ждут этого поиска
+    RowScratch& scratch = GetThreadScratch();
+    if (!scratch.row) {
+        scratch.row = std::make_shared<Row>();
+    }
+    scratch.row->from = from;
+    ComputeRow(*scratch.row, scratch.queue);
+
+    std::lock_guard lock(mutex_);
+    ++computed_row_count_;
+    if (auto row = FindRow(from)) {
+        // строку успел добавить другой поток, буфер остаётся для следующего вычисления
+        return row;
+    }
+    std::shared_ptr<Row> row = std::move(scratch.row);
+    if (rows_.size() == max_row_count_) {
+        // вытесненную строку ещё могут читать другие потоки: она освободится с последней ссылкой
+        rows_by_vertex_.erase(rows_.back()->from);
+        rows_.pop_back();
+    }
+    rows_.push_front(row);
+    rows_by_vertex_[from] = rows_.begin();
+    return row;
+}
+
+template <typename Weight>
+std::shared_ptr<const typename LazyRouter<Weight>::Row> LazyRouter<Weight>::FindRow(VertexId from) const {
+    auto it = rows_by_vertex_.find(from);
+    if (it == rows_by_vertex_.end()) {
+        return nullptr;
+    }
+    rows_.splice(rows_.begin(), rows_, it->second);
+    return rows_.front();
+}
+
+template <typename Weight>
+void LazyRouter<Weight>::ComputeRow(Row& row, std::vector<QueueItem>& queue) const {
+    row.weights.assign(graph_.GetVertexCount(), UNREACHABLE);
+    row.prev_edges.assign(graph_.GetVertexCount(), NO_EDGE);
+    row.weights[row.from] = WeightTraits<Weight>::ToValue(Weight{});
+
+    queue.clear();
+    queue.push_back({row.weights[row.from], row.from});
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), QueueCompare);
+        const QueueItem item = queue.back();
+        queue.pop_back();
+        if (row.weights[item.vertex] < item.weight) {
+            continue;
+        }
+        for (const auto& edge : graph_.GetOutgoingEdges(item.vertex)) {
+            const Value candidate_weight = item.weight + WeightTraits<Weight>::ToValue(edge.weight);
+            if (candidate_weight < row.weights[edge.to]) {
+                row.weights[edge.to] = candidate_weight;
+                row.prev_edges[edge.to] = edge.id;
+                queue.push_back({candidate_weight, edge.to});
+                std::push_heap(queue.begin(), queue.end(), QueueCompare);
+            }
+        }
+    }
+}
+
+template <typename Weight>
+typename LazyRouter<Weight>::RowScratch& LazyRouter<Weight>::GetThreadScratch() {
+    thread_local RowScratch scratch;
+    return scratch;
+}
+
+}  // namespace graph
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace cache {
+
+// Потокобезопасный кэш ограниченного размера с вытеснением давно не использованных записей.
+// Значения возвращаются копией, чтобы их не могла вытеснить другая нить во время чтения.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+    explicit LruCache(size_t capacity)
+        : capacity_(capacity) {
+        entries_by_key_.reserve(capacity);
+    }
+
+    // возвращает значение и делает запись самой свежей
+    std::optional<Value> Get(const Key& key) {
+        std::lock_guard lock(mutex_);
+        auto it = entries_by_key_.find(key);
+        if (it == entries_by_key_.end()) {
+            ++miss_count_;
+            return std::nullopt;
+        }
+        ++hit_count_;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->second;
+    }
+
+    // добавляет или обновляет запись, при переполнении вытесняет самую старую
+    void Put(const Key& key, Value value) {
+        if (capacity_ == 0) {
+            return;
+        }
+        std::lock_guard lock(mutex_);
+        auto it = entries_by_key_.find(key);
+        if (it != entries_by_key_.end()) {
+            it->second->second = std::move(value);
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return;
+        }
+        if (entries_.size() == capacity_) {
+            entries_by_key_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+        entries_.emplace_front(key, std::move(value));
+        entries_by_key_.emplace(key, entries_.begin());
+    }
+
+    size_t GetCapacity() const {
+        return capacity_;
+    }
+
+    size_t GetSize() const {
+        std::lock_guard lock(mutex_);
+        return entries_.size();
+    }
+
+    size_t GetHitCount() const {
+        std::lock_guard lock(mutex_);
+        return hit_count_;
+    }
+
+    size_t GetMissCount() const {
+        std::lock_guard lock(mutex_);
+        return miss_count_;
+    }
+
+private:
+    using Entries = std::list<std::pair<Key, Value>>;
+
+    const size_t capacity_;
+
+    mutable std::mutex mutex_;
+    // от самой свежей записи к самой старой
+    Entries entries_;
+    std::unordered_map<Key, typename Entries::iterator, Hash> entries_by_key_;
+    size_t hit_count_ = 0;
+    size_t miss_count_ = 0;
+};
+
+} // namespace cache
@@ -0,0 +1,169 @@
+#include "min_plus.h"
+
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MIN_PLUS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace graph::min_plus {
+
+namespace {
+
+using RelaxRowFunc = void (*)(double, uint32_t, const double*, const uint32_t*,
+                              double*, uint32_t*, size_t, size_t, uint32_t);
+
+// обрабатывает ячейки [begin, count)
+void RelaxRowScalar(double from_weight, uint32_t from_prev_edge,
+                    const double* through_weights, const uint32_t* through_prev_edges,
+                    double* weights, uint32_t* prev_edges, size_t begin, size_t count, uint32_t no_edge) {
+    for (size_t index = begin; index < count; ++index) {
+        const double candidate_weight = from_weight + through_weights[index];
+        if (candidate_weight < weights[index]) {
+            weights[index] = candidate_weight;
+            prev_edges[index] = through_prev_edges[index] != no_edge ? through_prev_edges[index] : from_prev_edge;
+        }
+    }
+}
+
+#ifdef MIN_PLUS_X86
+
+// 4 ячейки за шаг; маска сравнения double сжимается до 32-битных полос для prev_edges
+__attribute__((target("avx2")))
+void RelaxRowAvx2(double from_weight, uint32_t from_prev_edge,
+                  const double* through_weights, const uint32_t* through_prev_edges,
+                  double* weights, uint32_t* prev_edges, size_t begin, size_t count, uint32_t no_edge) {
+    const __m256d from_weights = _mm256_set1_pd(from_weight);
+    const __m128i from_prev_edges = _mm_set1_epi32(static_cast<int>(from_prev_edge));
+    const __m128i no_edges = _mm_set1_epi32(static_cast<int>(no_edge));
+    const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+
+    size_t index = begin;
+    for (; index + 4 <= count; index += 4) {
+        const __m256d candidate_weights = _mm256_add_pd(from_weights, _mm256_loadu_pd(through_weights + index));
+        const __m256d current_weights = _mm256_loadu_pd(weights + index);
+        const __m256d improved = _mm256_cmp_pd(candidate_weights, current_weights, _CMP_LT_OQ);
+        // улучшения редки - без них ничего не записываем
+        if (_mm256_movemask_pd(improved) == 0) {
+            continue;
+        }
+        _mm256_storeu_pd(weights + index, _mm256_blendv_pd(current_weights, candidate_weights, improved));
+
+        const __m128i improved_edges = _mm256_castsi256_si128(
+                _mm256_permutevar8x32_epi32(_mm256_castpd_si256(improved), low_halves));
+        const __m128i through_edges = _mm_loadu_si128(reinterpret_cast<const __m128i*>(through_prev_edges + index));
+        const __m128i new_edges = _mm_blendv_epi8(through_edges, from_prev_edges,
+                                                  _mm_cmpeq_epi32(through_edges, no_edges));
+        __m128i* edges = reinterpret_cast<__m128i*>(prev_edges + index);
+        _mm_storeu_si128(edges, _mm_blendv_epi8(_mm_loadu_si128(edges), new_edges, improved_edges));
+    }
+    RelaxRowScalar(from_weight, from_prev_edge, through_weights, through_prev_edges,
+                   weights, prev_edges, index, count, no_edge);
+}
+
+// 8 ячеек за шаг, запись по маске
+__attribute__((target("avx512f,avx512vl")))
+void RelaxRowAvx512(double from_weight, uint32_t from_prev_edge,
+                    const double* through_weights, const uint32_t* through_prev_edges,
+                    double* weights, uint32_t* prev_edges, size_t begin, size_t count, uint32_t no_edge) {
+    const __m512d from_weights = _mm512_set1_pd(from_weight);
+    const __m256i from_prev_edges = _mm256_set1_epi32(static_cast<int>(from_prev_edge));
+    const __m256i no_edges = _mm256_set1_epi32(static_cast<int>(no_edge));
+
+    size_t index = begin;
+    for (; index + 8 <= count; index += 8) {
+        const __m512d candidate_weights = _mm512_add_pd(from_weights, _mm512_loadu_pd(through_weights + index));
+        const __mmask8 improved = _mm512_cmp_pd_mask(candidate_weights, _mm512_loadu_pd(weights + index),
+                                                     _CMP_LT_OQ);
+        if (improved == 0) {
+            continue;
+        }
+        _mm512_mask_storeu_pd(weights + index, improved, candidate_weights);
+
+        const __m256i through_edges = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(through_prev_edges + index));
+        const __m256i new_edges = _mm256_mask_blend_epi32(_mm256_cmpeq_epi32_mask(through_edges, no_edges),
+                                                          through_edges, from_prev_edges);
+        _mm256_mask_storeu_epi32(prev_edges + index, improved, new_edges);
+    }
+    RelaxRowScalar(from_weight, from_prev_edge, through_weights, through_prev_edges,
+                   weights, prev_edges, index, count, no_edge);
+}
+
+#endif
+
+RelaxRowFunc GetRelaxRowFunc(Isa isa) {
+    switch (isa) {
+#ifdef MIN_PLUS_X86
+    case Isa::AVX512 :
+        return RelaxRowAvx512;
+    case Isa::AVX2 :
+        return RelaxRowAvx2;
+#endif
+    default:
+        return RelaxRowScalar;
+    }
+}
+
+Isa DetectIsa() {
+    if (IsSupported(Isa::AVX512)) {
+        return Isa::AVX512;
+    }
+    if (IsSupported(Isa::AVX2)) {
+        return Isa::AVX2;
+    }
+    return Isa::SCALAR;
+}
+
+} // namespace
+
+Isa GetIsa() {
+    static const Isa isa = DetectIsa();
+    return isa;
+}
+
+bool IsSupported(Isa isa) {
+    switch (isa) {
+#ifdef MIN_PLUS_X86
+    case Isa::AVX512 :
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl");
+    case Isa::AVX2 :
+        return __builtin_cpu_supports("avx2");
+#endif
+    case Isa::SCALAR :
+        return true;
+    default:
+        return false;
+    }
+}
+
+std::string_view GetIsaName(Isa isa) {
+    switch (isa) {
+    case Isa::AVX512 :
+        return "avx512";
+    case Isa::AVX2 :
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+void RelaxRow(double from_weight, uint32_t from_prev_edge,
+              const double* through_weights, const uint32_t* through_prev_edges,
+              double* weights, uint32_t* prev_edges, size_t count, uint32_t no_edge) {
+    static const RelaxRowFunc relax_row = GetRelaxRowFunc(GetIsa());
+    relax_row(from_weight, from_prev_edge, through_weights, through_prev_edges,
+              weights, prev_edges, 0, count, no_edge);
+}
+
+void RelaxRow(Isa isa, double from_weight, uint32_t from_prev_edge,
+              const double* through_weights, const uint32_t* through_prev_edges,
+              double* weights, uint32_t* prev_edges, size_t count, uint32_t no_edge) {
+    if (!IsSupported(isa)) {
+        throw std::invalid_argument("Instruction set is not supported");
+    }
+    GetRelaxRowFunc(isa)(from_weight, from_prev_edge, through_weights, through_prev_edges,
+                         weights, prev_edges, 0, count, no_edge);
+}
+
+} // namespace graph::min_plus
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace graph::min_plus {
+
+// Набор инструкций, которым выполняется релаксация строки
+enum class Isa {
+    SCALAR,
+    AVX2,
+    AVX512,
+};
+
+// лучший набор инструкций, поддерживаемый процессором (определяется один раз)
+Isa GetIsa();
+bool IsSupported(Isa isa);
+std::string_view GetIsaName(Isa isa);
+
+// Релаксация отрезка строки таблицы маршрутов через опорную вершину (min-plus):
+// weights[i] = min(weights[i], from_weight + through_weights[i]); при улучшении
+// prev_edges[i] = through_prev_edges[i], а если он равен no_edge - from_prev_edge.
+// Результат всех реализаций совпадает бит в бит со скалярной.
+void RelaxRow(double from_weight, uint32_t from_prev_edge,
+              const double* through_weights, const uint32_t* through_prev_edges,
+              double* weights, uint32_t* prev_edges, size_t count, uint32_t no_edge);
+
+// то же с явно заданным набором инструкций (для замеров), isa должен поддерживаться
+void RelaxRow(Isa isa, double from_weight, uint32_t from_prev_edge,
+              const double* through_weights, const uint32_t* through_prev_edges,
+              double* weights, uint32_t* prev_edges, size_t count, uint32_t no_edge);
+
+} // namespace graph::min_plus
@@ -0,0 +1,230 @@
+#include "raptor_router.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace transport_router {
+
+namespace {
+constexpr double INF = std::numeric_limits<double>::infinity();
+constexpr uint32_t NOT_SCANNED = std::numeric_limits<uint32_t>::max();
+} // namespace
+
+RaptorRouter::RaptorRouter(const transport_catalogue::TransportCatalogue& catalogue,
+                           const IdsByStopName& ids_by_stop_name,
+                           double wait_time, double velocity)
+    : wait_time_(wait_time)
+    , stop_count_(ids_by_stop_name.size())
+{
+    // порядок автобусов по имени делает выбор среди равных по времени маршрутов воспроизводимым
+    std::vector<const domain::Bus*> buses;
+    buses.reserve(catalogue.GetRoutes().size());
+    for (const auto& [name, bus] : catalogue.GetRoutes()) {
+        buses.push_back(bus);
+    }
+    std::sort(buses.begin(), buses.end(), [](const domain::Bus* lhs, const domain::Bus* rhs) {
+        return lhs->name < rhs->name;
+    });
+
+    for (const domain::Bus* bus : buses) {
+        if (bus->stops.size() < 2) {
+            continue;
+        }
+        AddPattern(*bus, false, catalogue, ids_by_stop_name, velocity);
+        if (bus->route_type == domain::RouteType::LINEAR) {
+            AddPattern(*bus, true, catalogue, ids_by_stop_name, velocity);
+        }
+    }
+
+    // события остановок сгруппированы по остановкам
+    stop_event_offsets_.assign(stop_count_ + 1, 0);
+    for (const uint32_t stop : pattern_stops_) {
+        ++stop_event_offsets_[stop + 1];
+    }
+    for (size_t stop = 0; stop < stop_count_; ++stop) {
+        stop_event_offsets_[stop + 1] += stop_event_offsets_[stop];
+    }
+    stop_events_.resize(pattern_stops_.size());
+    std::vector<uint32_t> fill_positions(stop_event_offsets_.begin(), stop_event_offsets_.end() - 1);
+    for (uint32_t pattern_id = 0; pattern_id < patterns_.size(); ++pattern_id) {
+        const Pattern& pattern = patterns_[pattern_id];
+        for (uint32_t position = 0; position < pattern.stop_count; ++position) {
+            const uint32_t stop = pattern_stops_[pattern.first_stop + position];
+            stop_events_[fill_positions[stop]++] = {pattern_id, position};
+        }
+    }
+}
+
+void RaptorRouter::AddPattern(const domain::Bus& bus, bool is_backward,
+                              const transport_catalogue::TransportCatalogue& catalogue,
+                              const IdsByStopName& ids_by_stop_name, double velocity) {
+    const size_t stop_count = bus.stops.size();
+    if (pattern_stops_.size() + stop_count > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Too many stops in bus routes");
+    }
+    // номер остановки автобуса на i-й позиции направления
+    auto stop_index = [&](size_t i) {
+        return is_backward ? stop_count - 1 - i : i;
+    };
+    Pattern pattern;
+    pattern.bus_name = bus.name;
+    pattern.first_stop = static_cast<uint32_t>(pattern_stops_.size());
+    pattern.stop_count = static_cast<uint32_t>(stop_count);
+    for (size_t i = 0; i < stop_count; ++i) {
+        pattern_stops_.push_back(static_cast<uint32_t>(ids_by_stop_name.at(bus.stops[stop_index(i)]->name)));
+        if (i + 1 == stop_count) {
+            hop_times_.push_back(0.0);
+        } else if (bus.HasDistances()) {
+            hop_times_.push_back(bus.GetDistance(stop_index(i), stop_index(i + 1)) / velocity);
+        } else {
+            // расстояния известны не все: ошибка об отсутствующем перегоне даётся каталогом
+            hop_times_.push_back(catalogue.GetDistance(bus.stops[stop_index(i)]->name,
+                                                       bus.stops[stop_index(i + 1)]->name) / velocity);
+        }
+    }
+    patterns_.push_back(pattern);
+}
+
+std::optional<RaptorRouter::Journey> RaptorRouter::BuildRoute(StopId from, StopId to, Scratch& scratch) const {
+    if (from >= stop_count_ || to >= stop_count_) {
+        throw std::out_of_range("Stop id is out of range");
+    }
+    if (from == to) {
+        return Journey{};
+    }
+
+    const size_t round = Search(from, to, scratch);
+    if (scratch.best_arrivals[to] == INF) {
+        return std::nullopt;
+    }
+    return MakeJourney(round, to, scratch);
+}
+
+void RaptorRouter::ComputeArrivals(StopId from, std::vector<double>& arrivals, Scratch& scratch) const {
+    if (from >= stop_count_) {
+        throw std::out_of_range("Stop id is out of range");
+    }
+    Search(from, NO_STOP, scratch);
+    arrivals.assign(scratch.best_arrivals.begin(), scratch.best_arrivals.end());
+}
+
+size_t RaptorRouter::Search(StopId from, StopId to, Scratch& scratch) const {
+    if (scratch.best_arrivals.size() != stop_count_ || scratch.scan_from.size() != patterns_.size()) {
+        scratch.best_arrivals.resize(stop_count_);
+        scratch.is_marked.assign(stop_count_, 0);
+        scratch.scan_from.assign(patterns_.size(), NOT_SCANNED);
+        scratch.scanned_patterns.clear();
+    }
+    scratch.labels.assign(stop_count_, Label{INF});
+    std::fill(scratch.best_arrivals.begin(), scratch.best_arrivals.end(), INF);
+    scratch.labels[from].arrival = 0;
+    scratch.best_arrivals[from] = 0;
+    scratch.marked_stops.assign(1, from);
+    scratch.is_marked[from] = 1;
+
+    size_t round = 0;
+    bool is_improved = true;
+    while (is_improved) {
+        ++round;
+        // метки нового раунда начинаются с меток предыдущего
+        scratch.labels.resize((round + 1) * stop_count_);
+        std::copy_n(scratch.labels.begin() + static_cast<std::ptrdiff_t>((round - 1) * stop_count_), stop_count_,
+                    scratch.labels.begin() + static_cast<std::ptrdiff_t>(round * stop_count_));
+        is_improved = ScanRound(round, to, scratch);
+    }
+    return round;
+}
+
+size_t RaptorRouter::GetStopCount() const {
+    return stop_count_;
+}
+
+size_t RaptorRouter::GetPatternCount() const {
+    return patterns_.size();
+}
+
+bool RaptorRouter::ScanRound(size_t round, StopId to, Scratch& scratch) const {
+    std::vector<uint32_t>& scan_from = scratch.scan_from;
+    // направления просматриваются от самой ранней улучшенной остановки
+    for (const StopId stop : scratch.marked_stops) {
+        scratch.is_marked[stop] = 0;
+        for (uint32_t i = stop_event_offsets_[stop]; i < stop_event_offsets_[stop + 1]; ++i) {
+            const StopEvent& event = stop_events_[i];
+            if (scan_from[event.pattern] == NOT_SCANNED) {
+                scratch.scanned_patterns.push_back(event.pattern);
+            }
+            scan_from[event.pattern] = std::min(scan_from[event.pattern], event.position);
+        }
+    }
+    scratch.marked_stops.clear();
+
+    // без цели отсечение по времени прибытия на неё не действует
+    const double no_target_arrival = INF;
+    const double& target_arrival = to != NO_STOP ? scratch.best_arrivals[to] : no_target_arrival;
+    const Label* previous_labels = scratch.labels.data() + (round - 1) * stop_count_;
+    Label* labels = scratch.labels.data() + round * stop_count_;
+    for (const uint32_t pattern_id : scratch.scanned_patterns) {
+        const Pattern& pattern = patterns_[pattern_id];
+        const uint32_t* stops = pattern_stops_.data() + pattern.first_stop;
+        const double* hop_times = hop_times_.data() + pattern.first_stop;
+
+        // время прибытия на текущую остановку, если ехать в автобусе
+        double on_board = INF;
+        uint32_t board_position = 0;
+        for (uint32_t position = scan_from[pattern_id]; position < pattern.stop_count; ++position) {
+            const StopId stop = stops[position];
+            if (on_board < std::min(scratch.best_arrivals[stop], target_arrival)) {
+                labels[stop] = {on_board, pattern_id, board_position, position, static_cast<uint32_t>(round)};
+                scratch.best_arrivals[stop] = on_board;
+                if (!scratch.is_marked[stop]) {
+                    scratch.is_marked[stop] = 1;
+                    scratch.marked_stops.push_back(stop);
+                }
+            }
+            // пересесть на этот автобус здесь выгоднее, чем ехать в нём с более ранней остановки
+            const double board_arrival = previous_labels[stop].arrival + wait_time_;
+            if (board_arrival < on_board) {
+                on_board = board_arrival;
+                board_position = position;
+            }
+            on_board += hop_times[position];
+        }
+        scan_from[pattern_id] = NOT_SCANNED;
+    }
+    scratch.scanned_patterns.clear();
+    return !scratch.marked_stops.empty();
+}
+
+RaptorRouter::Journey RaptorRouter::MakeJourney(size_t round, StopId to, const Scratch& scratch) const {
+    Journey journey;
+    StopId stop = to;
+    while (scratch.labels[round * stop_count_ + stop].pattern != NO_PATTERN) {
+        const Label& label = scratch.labels[round * stop_count_ + stop];
+        const Pattern& pattern = patterns_[label.pattern];
+        Leg leg;
+        leg.bus_name = pattern.bus_name;
+        leg.from = pattern_stops_[pattern.first_stop + label.board_position];
+        leg.to = stop;
+        leg.span_count = static_cast<int>(label.alight_position - label.board_position);
+        leg.time = ComputeLegTime(pattern, label.board_position, label.alight_position);
+        journey.push_back(leg);
+
+        stop = leg.from;
+        round = label.round - 1;
+    }
+    std::reverse(journey.begin(), journey.end());
+    return journey;
+}
+
+double RaptorRouter::ComputeLegTime(const Pattern& pattern, uint32_t board_position,
+                                    uint32_t alight_position) const {
+    // суммируем в том же порядке, что и при построении рёбер графа
+    double result = wait_time_;
+    for (uint32_t position = board_position; position < alight_position; ++position) {
+        result += hop_times_[pattern.first_stop + position];
+    }
+    return result;
+}
+
+} // namespace transport_router
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "transport_catalogue.h"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace transport_router {
+
+// Маршрутизатор RAPTOR: поиск по раундам прямо по последовательностям остановок автобусов.
+// Раунд k находит лучшие маршруты не более чем из k поездок, поэтому граф всех пар
+// остановок маршрута (O(k^2) рёбер на автобус) не нужен: память линейна по числу остановок
+// во всех маршрутах. Каждая посадка стоит wait_time, перегон - дорожное расстояние / velocity.
+// Рабочие буферы поиска вынесены в Scratch: маршрутизатор запросами не меняется,
+// и запросы с разными Scratch можно выполнять из нескольких потоков одновременно.
+class RaptorRouter {
+public:
+    using StopId = size_t;
+    using IdsByStopName = std::unordered_map<std::string_view, size_t>;
+
+    // поездка на одном автобусе
+    struct Leg {
+        std::string_view bus_name;
+        StopId from = 0;
+        StopId to = 0;
+        int span_count = 0;
+        double time = 0;    // ожидание и поездка
+    };
+    using Journey = std::vector<Leg>;
+
+    static constexpr uint32_t NO_PATTERN = UINT32_MAX;
+
+    // лучшее прибытие на остановку за раунд и поездка, которой оно достигнуто
+    struct Label {
+        double arrival = 0;
+        uint32_t pattern = NO_PATTERN;
+        uint32_t board_position = 0;
+        uint32_t alight_position = 0;
+        // раунд, в котором метка получена (метки переносятся в следующие раунды)
+        uint32_t round = 0;
+    };
+
+    // рабочие буферы одного потока; размеры подстраиваются под маршрутизатор при первом запросе
+    struct Scratch {
+        // метки раунда k лежат в labels[k * stop_count, (k + 1) * stop_count)
+        std::vector<Label> labels;
+        std::vector<double> best_arrivals;
+        std::vector<char> is_marked;
+        std::vector<StopId> marked_stops;
+        // самая ранняя позиция улучшенной остановки в направлении, UINT32_MAX - нет улучшений
+        std::vector<uint32_t> scan_from;
+        std::vector<uint32_t> scanned_patterns;
+    };
+
+    RaptorRouter(const transport_catalogue::TransportCatalogue& catalogue,
+                 const IdsByStopName& ids_by_stop_name,
+                 double wait_time, double velocity);
+
+    std::optional<Journey> BuildRoute(StopId from, StopId to, Scratch& scratch) const;
+    // время в пути от from до всех остановок (бесконечность - остановка недостижима)
+    void ComputeArrivals(StopId from, std::vector<double>& arrivals, Scratch& scratch) const;
+
+    size_t GetStopCount() const;
+    // число направлений движения (линейный маршрут даёт два)
+    size_t GetPatternCount() const;
+
+private:
+    // направление движения автобуса: остановки pattern_stops_[first_stop, first_stop + stop_count),
+    // hop_times_ с тем же смещением - время перегона до следующей остановки (у последней 0)
+    struct Pattern {
+        std::string_view bus_name;
+        uint32_t first_stop = 0;
+        uint32_t stop_count = 0;
+    };
+
+    // позиция остановки в направлении движения
+    struct StopEvent {
+        uint32_t pattern = 0;
+        uint32_t position = 0;
+    };
+
+    static constexpr StopId NO_STOP = SIZE_MAX;
+
+    // направление автобуса: прямое или (is_backward) обратный путь линейного маршрута
+    void AddPattern(const domain::Bus& bus, bool is_backward,
+                    const transport_catalogue::TransportCatalogue& catalogue,
+                    const IdsByStopName& ids_by_stop_name, double velocity);
+    // раунды поиска из from до исчерпания улучшений, возвращает номер последнего раунда
+    // to - цель для отсечения, NO_STOP - без цели
+    size_t Search(StopId from, StopId to, Scratch& scratch) const;
+    // просматривает направления, проходящие через улучшенные в прошлом раунде остановки,
+    // возвращает true, если улучшена хотя бы одна остановка
+    bool ScanRound(size_t round, StopId to, Scratch& scratch) const;
+    Journey MakeJourney(size_t round, StopId to, const Scratch& scratch) const;
+    double ComputeLegTime(const Pattern& pattern, uint32_t board_position, uint32_t alight_position) const;
+
+    double wait_time_ = 0;
+    size_t stop_count_ = 0;
+
+    std::vector<Pattern> patterns_;
+    std::vector<uint32_t> pattern_stops_;
+    std::vector<double> hop_times_;
+    // события остановки s: stop_events_[stop_event_offsets_[s], stop_event_offsets_[s + 1])
+    std::vector<uint32_t> stop_event_offsets_;
+    std::vector<StopEvent> stop_events_;
+};
+
+} // namespace transport_router
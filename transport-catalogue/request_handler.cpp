@@ -39,10 +39,19 @@ namespace transport_catalogue {
     }
     
     
-    std::optional<RequestHandler::Bus>
-    RequestHandler::BuildRoute(const std::string &from, const std::string &to) {
+    bool RequestHandler::BuildRouter() {
         if (!InitRouter()) {
             std::cerr << "Can't init Transport Router"s << std::endl;
+            return false;
+        }
+        router_->InitRouter();
+        return true;
+    }
+    
+    std::optional<RequestHandler::Bus>
+    RequestHandler::BuildRoute(const std::string &from, const std::string &to) const {
+        if (!router_ || !router_->IsInitialized()) {
+            std::cerr << "Transport Router is not built"s << std::endl;
             return std::nullopt;
         } else {
             return router_->BuildRoute(from, to);
@@ -69,8 +78,7 @@ namespace transport_catalogue {
     void RequestHandler::LoadRequestsAndAnswer(const json_reader::JsonLoader& json, std::ostream& out) {
 
         
-        if (!InitRouter()) {
-            std::cerr << "Can't init Transport Router"s << std::endl;
+        if (!BuildRouter()) {
             return;
         }
         
@@ -90,8 +98,7 @@ namespace transport_catalogue {
         }
         
         if (routing_settings_) {
-            InitRouter();
-            router_->InitRouter();
+            BuildRouter();
             serializator.AddTransportRouter(*router_.get());
         }
         
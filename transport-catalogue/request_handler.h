@@ -33,8 +33,9 @@ public:
     // возвращает сформированную "карту" маршрутов в формате svg-документа
     svg::Document RenderMap() const;
 
-    // Возвращает маршрут между двумя остановками
-    std::optional<Bus> BuildRoute(const std::string& from, const std::string& to);
+    // Возвращает маршрут между двумя остановками, маршрутизатор должен быть построен (BuildRouter).
+    // Не меняет обработчик, поэтому безопасен для одновременных вызовов
+    std::optional<Bus> BuildRoute(const std::string& from, const std::string& to) const;
 
     // загружает все доступные данные из JSON
     void LoadDataFromJson(const json_reader::JsonLoader& json);
@@ -51,6 +52,9 @@ public:
     // Принудительно переинициализирует маршрутизатор
     bool ReInitRouter();
 
+    // Строит маршрутизатор (если он ещё не построен) до первых запросов маршрутов
+    bool BuildRouter();
+
     // методы для ручного выставления настроек
     void SetRenderSettings(const renderer::RenderSettings& render_settings);
     void SetRoutingSettings(const RoutingSettings& routing_settings);
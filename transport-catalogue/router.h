@@ -1,26 +1,40 @@
 #pragma once
 
 #include "graph.h"
+#include "min_plus.h"
+#include "thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <iterator>
+#include <limits>
 #include <optional>
 #include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace graph {
 
-template <typename Weight>
+// Таблица маршрутов между всеми парами вершин. Последние рёбра маршрутов хранятся типом Id графа
+template <typename Weight, typename Id = uint32_t>
 class Router {
 private:
-    using Graph = DirectedWeightedGraph<Weight>;
+    using Graph = DirectedWeightedGraph<Weight, Id>;
+    using Value = typename WeightTraits<Weight>::Value;
 
 public:
-    explicit Router(const Graph& graph, bool initialize = true);
+    // Способ заполнения таблицы маршрутов
+    enum class Algorithm {
+        SEQUENTIAL,  // классический цикл Флойда-Уоршелла по опорным вершинам
+        BLOCKED,     // блочный вариант, блоки каждой фазы обрабатываются параллельно
+        DIJKSTRA,    // поиск Дейкстры из каждой вершины (как в алгоритме Джонсона), вершины - параллельно.
+                     // O(V * E log V) вместо O(V^3): для разреженного графа намного быстрее
+    };
+
+    explicit Router(const Graph& graph, bool initialize = true, Algorithm algorithm = Algorithm::BLOCKED);
 
     struct RouteInfo {
         Weight weight;
@@ -29,53 +43,299 @@ public:
 
     std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
 
-    struct RouteInternalData {
-        Weight weight;
-        std::optional<EdgeId> prev_edge;
+    // Маршрут в память вызывающего: edges очищается и заполняется рёбрами маршрута
+    // от первого к последнему, выделение памяти - только при нехватке ёмкости edges
+    std::optional<Weight> BuildRoute(VertexId from, VertexId to, std::vector<EdgeId>& edges) const;
+
+    // Передаёт рёбра маршрута в visitor(EdgeId) от последнего к первому (в порядке
+    // восстановления по таблице) без выделения памяти; nullopt - маршрута нет
+    template <typename Visitor>
+    std::optional<Weight> VisitRouteEdges(VertexId from, VertexId to, Visitor&& visitor) const;
+
+    // Дополняет таблицу рёбрами графа с номерами от first_edge_id, добавленными после её построения.
+    // Для каждого ребра u -> v веса w: [i][j] = min([i][j], [i][u] + w + [v][j]).
+    // При неотрицательных весах строка v и столбец u от ребра не меняются, поэтому
+    // рёбра учитываются по одному за O(V^2), а строки, где ребро не улучшает [i][v], пропускаются
+    void AddEdges(EdgeId first_edge_id);
+
+    // Таблица маршрутов между всеми парами вершин в виде двух плотных матриц,
+    // хранящихся по строкам: веса маршрутов (UNREACHABLE - маршрута нет)
+    // и последние рёбра маршрутов (NO_EDGE - маршрут из вершины в саму себя)
+    class RoutesInternalData {
+    public:
+        static constexpr Value UNREACHABLE = std::numeric_limits<Value>::infinity();
+        static constexpr Id NO_EDGE = std::numeric_limits<Id>::max();
+
+        RoutesInternalData() = default;
+        explicit RoutesInternalData(size_t vertex_count)
+            : vertex_count_(vertex_count)
+            , weights_(vertex_count * vertex_count, UNREACHABLE)
+            , prev_edges_(vertex_count * vertex_count, NO_EDGE) {
+        }
+
+        size_t GetVertexCount() const {
+            return vertex_count_;
+        }
+
+        // строки матриц для вершины from
+        Value* GetWeights(VertexId from) {
+            return weights_.data() + from * vertex_count_;
+        }
+        const Value* GetWeights(VertexId from) const {
+            return weights_.data() + from * vertex_count_;
+        }
+        Id* GetPrevEdges(VertexId from) {
+            return prev_edges_.data() + from * vertex_count_;
+        }
+        const Id* GetPrevEdges(VertexId from) const {
+            return prev_edges_.data() + from * vertex_count_;
+        }
+
+        // матрицы целиком - для "ручного" заполнения
+        std::vector<Value>& GetWeights() {
+            return weights_;
+        }
+        const std::vector<Value>& GetWeights() const {
+            return weights_;
+        }
+        std::vector<Id>& GetPrevEdges() {
+            return prev_edges_;
+        }
+        const std::vector<Id>& GetPrevEdges() const {
+            return prev_edges_;
+        }
+
+    private:
+        size_t vertex_count_ = 0;
+        std::vector<Value> weights_;
+        std::vector<Id> prev_edges_;
     };
-    using RoutesInternalData = std::vector<std::vector<std::optional<RouteInternalData>>>;
 
 private:
 
     void InitializeRoutesInternalData(const Graph& graph) {
+        if (graph.GetEdgeCount() >= RoutesInternalData::NO_EDGE) {
+            throw std::length_error("Too many edges for the routes table");
+        }
         const size_t vertex_count = graph.GetVertexCount();
         for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
-            routes_internal_data_[vertex][vertex] = RouteInternalData{ZERO_WEIGHT, std::nullopt};
-            for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
-                const auto& edge = graph.GetEdge(edge_id);
+            Value* weights = routes_internal_data_.GetWeights(vertex);
+            Id* prev_edges = routes_internal_data_.GetPrevEdges(vertex);
+            weights[vertex] = WeightTraits<Weight>::ToValue(ZERO_WEIGHT);
+            for (const auto& edge : graph.GetOutgoingEdges(vertex)) {
                 if (edge.weight < ZERO_WEIGHT) {
                     throw std::domain_error("Edges' weights should be non-negative");
                 }
-                auto& route_internal_data = routes_internal_data_[vertex][edge.to];
-                if (!route_internal_data || route_internal_data->weight > edge.weight) {
-                    route_internal_data = RouteInternalData{edge.weight, edge_id};
+                const Value edge_weight = WeightTraits<Weight>::ToValue(edge.weight);
+                if (edge_weight < weights[edge.to]) {
+                    weights[edge.to] = edge_weight;
+                    prev_edges[edge.to] = static_cast<Id>(edge.id);
                 }
             }
         }
     }
 
-    void RelaxRoute(VertexId vertex_from, VertexId vertex_to, const RouteInternalData& route_from,
-                    const RouteInternalData& route_to) {
-        auto& route_relaxing = routes_internal_data_[vertex_from][vertex_to];
-        const Weight candidate_weight = route_from.weight + route_to.weight;
-        if (!route_relaxing || candidate_weight < route_relaxing->weight) {
-            route_relaxing = {candidate_weight,
-                              route_to.prev_edge ? route_to.prev_edge : route_from.prev_edge};
+    struct QueueItem {
+        Value weight;
+        VertexId vertex;
+    };
+
+    static bool QueueCompare(const QueueItem& lhs, const QueueItem& rhs) {
+        return lhs.weight > rhs.weight;
+    }
+
+    // Заполняет таблицу поисками Дейкстры из каждой вершины. Строки независимы и
+    // раздаются пулу потоков пачками, у каждой пачки своя очередь поиска
+    void ComputeRoutesInternalDataDijkstra(const Graph& graph) {
+        // строк в пачке: очередь переиспользуется, а пачек достаточно для выравнивания нагрузки
+        constexpr size_t ROWS_PER_TASK = 16;
+
+        if (graph.GetEdgeCount() >= RoutesInternalData::NO_EDGE) {
+            throw std::length_error("Too many edges for the routes table");
+        }
+        for (const auto& edge : graph.GetEdges()) {
+            if (edge.weight < ZERO_WEIGHT) {
+                throw std::domain_error("Edges' weights should be non-negative");
+            }
+        }
+        const size_t vertex_count = graph.GetVertexCount();
+        const size_t task_count = (vertex_count + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+        concurrency::ThreadPool pool(task_count > 1 ? 0 : 1);
+        pool.ParallelFor(task_count, [&](size_t task) {
+            std::vector<QueueItem> queue;
+            const VertexId end = std::min((task + 1) * ROWS_PER_TASK, vertex_count);
+            for (VertexId from = task * ROWS_PER_TASK; from < end; ++from) {
+                ComputeRowDijkstra(graph, from, queue);
+            }
+        });
+    }
+
+    // строка маршрутов из from; строка должна быть пустой (UNREACHABLE и NO_EDGE)
+    void ComputeRowDijkstra(const Graph& graph, VertexId from, std::vector<QueueItem>& queue) {
+        Value* weights = routes_internal_data_.GetWeights(from);
+        Id* prev_edges = routes_internal_data_.GetPrevEdges(from);
+        weights[from] = WeightTraits<Weight>::ToValue(ZERO_WEIGHT);
+        queue.clear();
+        queue.push_back({weights[from], from});
+        while (!queue.empty()) {
+            std::pop_heap(queue.begin(), queue.end(), QueueCompare);
+            const QueueItem item = queue.back();
+            queue.pop_back();
+            if (weights[item.vertex] < item.weight) {
+                continue;
+            }
+            for (const auto& edge : graph.GetOutgoingEdges(item.vertex)) {
+                const Value candidate_weight = item.weight + WeightTraits<Weight>::ToValue(edge.weight);
+                if (candidate_weight < weights[edge.to]) {
+                    weights[edge.to] = candidate_weight;
+                    prev_edges[edge.to] = static_cast<Id>(edge.id);
+                    queue.push_back({candidate_weight, edge.to});
+                    std::push_heap(queue.begin(), queue.end(), QueueCompare);
+                }
+            }
+        }
+    }
+
+    // Релаксирует отрезок строки маршрутов из вершины from через опорную вершину:
+    // from_weight/from_prev_edge - маршрут from -> through,
+    // through_weights/through_prev_edges - отрезок строки маршрутов из through.
+    // Для весов double используется векторная реализация под процессор
+    static void RelaxRow(Value from_weight, Id from_prev_edge,
+                         const Value* through_weights, const Id* through_prev_edges,
+                         Value* weights, Id* prev_edges, size_t count) {
+        if constexpr (std::is_same_v<Value, double> && std::is_same_v<Id, uint32_t>) {
+            min_plus::RelaxRow(from_weight, from_prev_edge, through_weights, through_prev_edges,
+                               weights, prev_edges, count, RoutesInternalData::NO_EDGE);
+        } else {
+            for (size_t index = 0; index < count; ++index) {
+                const Value candidate_weight = from_weight + through_weights[index];
+                if (candidate_weight < weights[index]) {
+                    weights[index] = candidate_weight;
+                    prev_edges[index] = through_prev_edges[index] != RoutesInternalData::NO_EDGE
+                            ? through_prev_edges[index] : from_prev_edge;
+                }
+            }
         }
     }
 
     void RelaxRoutesInternalDataThroughVertex(size_t vertex_count, VertexId vertex_through) {
+        const Value* through_weights = routes_internal_data_.GetWeights(vertex_through);
+        const Id* through_prev_edges = routes_internal_data_.GetPrevEdges(vertex_through);
         for (VertexId vertex_from = 0; vertex_from < vertex_count; ++vertex_from) {
-            if (const auto& route_from = routes_internal_data_[vertex_from][vertex_through]) {
-                for (VertexId vertex_to = 0; vertex_to < vertex_count; ++vertex_to) {
-                    if (const auto& route_to = routes_internal_data_[vertex_through][vertex_to]) {
-                        RelaxRoute(vertex_from, vertex_to, *route_from, *route_to);
-                    }
+            Value* weights = routes_internal_data_.GetWeights(vertex_from);
+            Id* prev_edges = routes_internal_data_.GetPrevEdges(vertex_from);
+            if (weights[vertex_through] != RoutesInternalData::UNREACHABLE) {
+                RelaxRow(weights[vertex_through], prev_edges[vertex_through],
+                         through_weights, through_prev_edges, weights, prev_edges, vertex_count);
+            }
+        }
+    }
+
+    // Полуинтервал номеров вершин
+    struct VertexRange {
+        VertexId begin;
+        VertexId end;
+    };
+
+    // Строки и столбцы опорных вершин блока на момент обработки каждой из них
+    struct PivotsData {
+        explicit PivotsData(size_t vertex_count)
+            : row_weights(BLOCK_SIZE * vertex_count)
+            , row_prev_edges(BLOCK_SIZE * vertex_count)
+            , column_weights(BLOCK_SIZE * vertex_count)
+            , column_prev_edges(BLOCK_SIZE * vertex_count) {
+        }
+
+        std::vector<Value> row_weights;
+        std::vector<Id> row_prev_edges;
+        std::vector<Value> column_weights;
+        std::vector<Id> column_prev_edges;
+    };
+
+    // Блочный Флойд-Уоршелл. Для каждого блока опорных вершин K обрабатываются:
+    // 1) блок K×K, 2) блоки строки и столбца K, 3) все остальные блоки.
+    // Блоки внутри фаз 2 и 3 независимы и обрабатываются в пуле потоков.
+    // Чтобы результат совпадал с последовательным циклом бит в бит, ячейка [i][j]
+    // релаксируется через опорную вершину k теми же значениями [i][k] и [k][j],
+    // что и в последовательном цикле: строка и столбец k запоминаются в момент
+    // обработки k (во время обработки k они не меняются).
+    void RelaxRoutesInternalDataBlocked(size_t vertex_count) {
+        const size_t block_count = (vertex_count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        const auto get_block = [vertex_count](size_t block) {
+            return VertexRange{block * BLOCK_SIZE, std::min((block + 1) * BLOCK_SIZE, vertex_count)};
+        };
+
+        PivotsData pivots_data(vertex_count);
+        concurrency::ThreadPool pool(block_count > 1 ? 0 : 1);
+
+        for (size_t pivot_block = 0; pivot_block < block_count; ++pivot_block) {
+            const VertexRange pivots = get_block(pivot_block);
+
+            RelaxBlock(vertex_count, pivots, pivots, pivots, pivots_data, true, true);
+
+            pool.ParallelFor(2 * block_count, [&](size_t task) {
+                const size_t block = task / 2;
+                if (block == pivot_block) {
+                    return;
+                }
+                if (task % 2 == 0) {
+                    RelaxBlock(vertex_count, pivots, pivots, get_block(block), pivots_data, true, false);
+                } else {
+                    RelaxBlock(vertex_count, pivots, get_block(block), pivots, pivots_data, false, true);
+                }
+            });
+
+            pool.ParallelFor(block_count * block_count, [&](size_t task) {
+                const size_t rows_block = task / block_count;
+                const size_t columns_block = task % block_count;
+                if (rows_block == pivot_block || columns_block == pivot_block) {
+                    return;
+                }
+                RelaxBlock(vertex_count, pivots, get_block(rows_block), get_block(columns_block),
+                           pivots_data, false, false);
+            });
+        }
+    }
+
+    // Релаксирует ячейки блока rows×columns через опорные вершины pivots.
+    // save_rows/save_columns - блок содержит строки/столбцы опорных вершин,
+    // и их значения нужно запомнить для остальных блоков
+    void RelaxBlock(size_t vertex_count, VertexRange pivots, VertexRange rows, VertexRange columns,
+                    PivotsData& pivots_data, bool save_rows, bool save_columns) {
+        const size_t columns_count = columns.end - columns.begin;
+        for (VertexId vertex_through = pivots.begin; vertex_through < pivots.end; ++vertex_through) {
+            const size_t offset = (vertex_through - pivots.begin) * vertex_count;
+            Value* row_weights = pivots_data.row_weights.data() + offset;
+            Id* row_prev_edges = pivots_data.row_prev_edges.data() + offset;
+            Value* column_weights = pivots_data.column_weights.data() + offset;
+            Id* column_prev_edges = pivots_data.column_prev_edges.data() + offset;
+
+            if (save_rows) {
+                std::copy_n(routes_internal_data_.GetWeights(vertex_through) + columns.begin,
+                            columns_count, row_weights + columns.begin);
+                std::copy_n(routes_internal_data_.GetPrevEdges(vertex_through) + columns.begin,
+                            columns_count, row_prev_edges + columns.begin);
+            }
+            if (save_columns) {
+                for (VertexId vertex_from = rows.begin; vertex_from < rows.end; ++vertex_from) {
+                    column_weights[vertex_from] = routes_internal_data_.GetWeights(vertex_from)[vertex_through];
+                    column_prev_edges[vertex_from] = routes_internal_data_.GetPrevEdges(vertex_from)[vertex_through];
+                }
+            }
+            for (VertexId vertex_from = rows.begin; vertex_from < rows.end; ++vertex_from) {
+                if (column_weights[vertex_from] != RoutesInternalData::UNREACHABLE) {
+                    RelaxRow(column_weights[vertex_from], column_prev_edges[vertex_from],
+                             row_weights + columns.begin, row_prev_edges + columns.begin,
+                             routes_internal_data_.GetWeights(vertex_from) + columns.begin,
+                             routes_internal_data_.GetPrevEdges(vertex_from) + columns.begin,
+                             columns_count);
                 }
             }
         }
     }
 
+    // сторона блока в вершинах
+    static constexpr size_t BLOCK_SIZE = 64;
     static constexpr Weight ZERO_WEIGHT{};
     const Graph& graph_;
     RoutesInternalData routes_internal_data_;
@@ -89,40 +349,102 @@ public:
     }
 };
 
-template <typename Weight>
-Router<Weight>::Router(const Graph& graph, bool initialize)
+template <typename Weight, typename Id>
+Router<Weight, Id>::Router(const Graph& graph, bool initialize, Algorithm algorithm)
     : graph_(graph)
-    , routes_internal_data_(graph.GetVertexCount(),
-                            std::vector<std::optional<RouteInternalData>>(graph.GetVertexCount()))
+    , routes_internal_data_(graph.GetVertexCount())
 {
-    if (initialize) {
+    if (initialize && algorithm == Algorithm::DIJKSTRA) {
+        ComputeRoutesInternalDataDijkstra(graph);
+    } else if (initialize) {
         InitializeRoutesInternalData(graph);
 
         const size_t vertex_count = graph.GetVertexCount();
-        for (VertexId vertex_through = 0; vertex_through < vertex_count; ++vertex_through) {
-            RelaxRoutesInternalDataThroughVertex(vertex_count, vertex_through);
+        if (algorithm == Algorithm::BLOCKED) {
+            RelaxRoutesInternalDataBlocked(vertex_count);
+        } else {
+            for (VertexId vertex_through = 0; vertex_through < vertex_count; ++vertex_through) {
+                RelaxRoutesInternalDataThroughVertex(vertex_count, vertex_through);
+            }
         }
     }
 }
 
-template <typename Weight>
-std::optional<typename Router<Weight>::RouteInfo> Router<Weight>::BuildRoute(VertexId from,
-                                                                             VertexId to) const {
-    const auto& route_internal_data = routes_internal_data_.at(from).at(to);
-    if (!route_internal_data) {
+template <typename Weight, typename Id>
+std::optional<typename Router<Weight, Id>::RouteInfo> Router<Weight, Id>::BuildRoute(VertexId from,
+                                                                                 VertexId to) const {
+    std::vector<EdgeId> edges;
+    auto weight = BuildRoute(from, to, edges);
+    if (!weight) {
         return std::nullopt;
     }
-    const Weight weight = route_internal_data->weight;
-    std::vector<EdgeId> edges;
-    for (std::optional<EdgeId> edge_id = route_internal_data->prev_edge;
-         edge_id;
-         edge_id = routes_internal_data_[from][graph_.GetEdge(*edge_id).from]->prev_edge)
+    return RouteInfo{*weight, std::move(edges)};
+}
+
+template <typename Weight, typename Id>
+std::optional<Weight> Router<Weight, Id>::BuildRoute(VertexId from, VertexId to, std::vector<EdgeId>& edges) const {
+    edges.clear();
+    auto weight = VisitRouteEdges(from, to, [&edges](EdgeId edge_id) {
+        edges.push_back(edge_id);
+    });
+    std::reverse(edges.begin(), edges.end());
+    return weight;
+}
+
+template <typename Weight, typename Id>
+template <typename Visitor>
+std::optional<Weight> Router<Weight, Id>::VisitRouteEdges(VertexId from, VertexId to, Visitor&& visitor) const {
+    const size_t vertex_count = routes_internal_data_.GetVertexCount();
+    if (from >= vertex_count || to >= vertex_count) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    const Value weight = routes_internal_data_.GetWeights(from)[to];
+    if (weight == RoutesInternalData::UNREACHABLE) {
+        return std::nullopt;
+    }
+    const Id* prev_edges = routes_internal_data_.GetPrevEdges(from);
+    for (Id edge_id = prev_edges[to];
+         edge_id != RoutesInternalData::NO_EDGE;
+         edge_id = prev_edges[graph_.GetEdge(edge_id).from])
     {
-        edges.push_back(*edge_id);
+        visitor(static_cast<EdgeId>(edge_id));
     }
-    std::reverse(edges.begin(), edges.end());
+    return WeightTraits<Weight>::FromValue(weight);
+}
 
-    return RouteInfo{weight, std::move(edges)};
+template <typename Weight, typename Id>
+void Router<Weight, Id>::AddEdges(EdgeId first_edge_id) {
+    if (graph_.GetEdgeCount() >= RoutesInternalData::NO_EDGE) {
+        throw std::length_error("Too many edges for the routes table");
+    }
+    const size_t vertex_count = routes_internal_data_.GetVertexCount();
+    if (graph_.GetVertexCount() != vertex_count) {
+        throw std::logic_error("Graph vertex count differs from the routes table");
+    }
+    for (EdgeId edge_id = first_edge_id; edge_id < graph_.GetEdgeCount(); ++edge_id) {
+        const auto& edge = graph_.GetEdge(edge_id);
+        if (edge.weight < ZERO_WEIGHT) {
+            throw std::domain_error("Edges' weights should be non-negative");
+        }
+        const Value edge_weight = WeightTraits<Weight>::ToValue(edge.weight);
+        // ребро, не улучшающее маршрут u -> v, не улучшает и маршруты через себя
+        if (!(edge_weight < routes_internal_data_.GetWeights(edge.from)[edge.to])) {
+            continue;
+        }
+        const Value* through_weights = routes_internal_data_.GetWeights(edge.to);
+        const Id* through_prev_edges = routes_internal_data_.GetPrevEdges(edge.to);
+        for (VertexId vertex_from = 0; vertex_from < vertex_count; ++vertex_from) {
+            Value* weights = routes_internal_data_.GetWeights(vertex_from);
+            if (weights[edge.from] == RoutesInternalData::UNREACHABLE) {
+                continue;
+            }
+            const Value from_weight = weights[edge.from] + edge_weight;
+            if (from_weight < weights[edge.to]) {
+                RelaxRow(from_weight, static_cast<Id>(edge_id), through_weights, through_prev_edges,
+                         weights, routes_internal_data_.GetPrevEdges(vertex_from), vertex_count);
+            }
+        }
+    }
 }
 
 }  // namespace graph
@@ -1,6 +1,8 @@
 #include "serialization.h"
 
+#include <algorithm>
 #include <fstream>
+#include <stdexcept>
 
 namespace serialize {
 
@@ -18,8 +20,20 @@ void Serializator::AddRenderSettings(const renderer::RenderSettings &settings) {
 void Serializator::AddTransportRouter(const transport_router::TransportRouter &router) {
     SaveTransportRouter(router);
     SaveTransportRouterSettings(router.GetSettings());
-    SaveGraph(router.GetGraph());
-    SaveRouter(router.GetRouter());
+    SaveGraph(router.GetGraph(), router.GetBusesById());
+    // для поиска Дейкстры таблица маршрутов не строится
+    if (router.GetRouter()) {
+        SaveRouter(router.GetRouter());
+    }
+    if (router.GetContractionHierarchy()) {
+        SaveContractionHierarchy(*router.GetContractionHierarchy());
+    }
+    if (router.GetHubLabels()) {
+        SaveHubLabels(*router.GetHubLabels());
+    }
+    if (!router.GetChainEdges().offsets.empty()) {
+        SaveChainEdges(router.GetChainEdges(), router.GetBusesById());
+    }
 }
 
 bool Serializator::Serialize() {
@@ -41,8 +55,8 @@ bool Serializator::Deserialize(TransportCatalogue &catalogue,
     }
 
     LoadStops(catalogue);
-    LoadBuses(catalogue);
     LoadDistances(catalogue);
+    LoadBuses(catalogue);
 
     LoadRenderSettings(settings);
 
@@ -134,10 +148,12 @@ void Serializator::SaveRenderSettings(const renderer::RenderSettings &settings)
 
 void Serializator::SaveTransportRouter(const TransportRouter &router) {
     auto p_stops_by_id = proto_catalogue_.mutable_router()->mutable_stop_by_id();
-    for (auto [name, id] : router.GetIdsByStopName()) {
+    // номера остановок маршрутизатора не совпадают с номерами в базе и сохраняются по порядку
+    const auto &stops_by_id = router.GetStopsById();
+    for (size_t id = 0; id < stops_by_id.size(); ++id) {
         transport_router_serialize::StopById stop_by_id;
-        stop_by_id.set_id(id);
-        stop_by_id.set_stop_id(stop_id_by_name_.at(name));
+        stop_by_id.set_id(static_cast<uint32_t>(id));
+        stop_by_id.set_stop_id(stop_id_by_name_.at(stops_by_id[id]->name));
         *p_stops_by_id->Add() = std::move(stop_by_id);
     }
 }
@@ -148,17 +164,24 @@ void Serializator::SaveTransportRouterSettings(const TransportRouter::RoutingSet
 
     p_settings->set_wait_time(routing_settings.wait_time);
     p_settings->set_velocity(routing_settings.velocity);
+    p_settings->set_engine(MakeProtoRoutingEngine(routing_settings.engine));
+    p_settings->set_route_cache_size(static_cast<uint32_t>(routing_settings.route_cache_size));
+    p_settings->set_lazy_row_limit(static_cast<uint32_t>(routing_settings.lazy_row_limit));
+    p_settings->set_graph_model(MakeProtoGraphModel(routing_settings.graph_model));
+    p_settings->set_hub_labels(routing_settings.hub_labels);
+    p_settings->set_all_pairs_algorithm(MakeProtoAllPairsAlgorithm(routing_settings.all_pairs_algorithm));
+    p_settings->set_compress_chains(routing_settings.compress_chains);
 }
 
 
-void Serializator::SaveGraph(const TransportRouter::Graph &graph) {
+void Serializator::SaveGraph(const TransportRouter::Graph &graph, const TransportRouter::BusesById &buses_by_id) {
     auto p_graph = proto_catalogue_.mutable_router()->mutable_graph();
 
     for (auto &edge : graph.GetEdges()) {
         graph_serialize::Edge p_edge;
         p_edge.set_from(edge.from);
         p_edge.set_to(edge.to);
-        *p_edge.mutable_weight() = MakeProtoWeight(edge.weight);
+        *p_edge.mutable_weight() = MakeProtoWeight(edge.weight, buses_by_id);
         *p_graph->add_edges() = std::move(p_edge);
     }
 
@@ -174,22 +197,43 @@ void Serializator::SaveGraph(const TransportRouter::Graph &graph) {
 
 void Serializator::SaveRouter(const std::unique_ptr<TransportRouter::Router> &router) {
     auto p_router = proto_catalogue_.mutable_router()->mutable_router();
+    auto &routes_internal_data = router->GetRoutesInternalData();
 
-    for (const auto &data : router->GetRoutesInternalData()) {
-        graph_serialize::RoutesInternalData p_data;
-        for (const auto &internal : data) {
-            graph_serialize::OptionalRouteInternalData p_internal;
-            if (internal.has_value()) {
-                auto &value = internal.value();
-                auto p_value = p_internal.mutable_route_internal_data();
-                p_value->set_total_time(value.weight.total_time);
-                if (value.prev_edge.has_value()) {
-                    p_value->set_prev_edge(value.prev_edge.value());
-                }
-            }
-            *p_data.add_routes_internal_data() = std::move(p_internal);
-        }
-        *p_router->add_routes_internal_data() = std::move(p_data);
+    auto &weights = routes_internal_data.GetWeights();
+    p_router->mutable_weights()->Add(weights.begin(), weights.end());
+    auto &prev_edges = routes_internal_data.GetPrevEdges();
+    p_router->mutable_prev_edges()->Add(prev_edges.begin(), prev_edges.end());
+}
+
+void Serializator::SaveContractionHierarchy(const TransportRouter::ContractionHierarchy &hierarchy) {
+    auto p_hierarchy = proto_catalogue_.mutable_router()->mutable_contraction_hierarchy();
+
+    for (auto rank : hierarchy.GetRanks()) {
+        p_hierarchy->add_ranks(rank);
+    }
+    for (auto &shortcut : hierarchy.GetShortcuts()) {
+        auto p_shortcut = p_hierarchy->add_shortcuts();
+        p_shortcut->set_from(shortcut.from);
+        p_shortcut->set_to(shortcut.to);
+        p_shortcut->set_total_time(shortcut.weight.total_time);
+        p_shortcut->set_first(shortcut.first);
+        p_shortcut->set_second(shortcut.second);
+    }
+}
+
+void Serializator::SaveHubLabels(const TransportRouter::HubLabels &hub_labels) {
+    auto p_hub_labels = proto_catalogue_.mutable_router()->mutable_hub_labels();
+    *p_hub_labels->mutable_forward() = MakeProtoLabels(hub_labels.GetForwardLabels());
+    *p_hub_labels->mutable_backward() = MakeProtoLabels(hub_labels.GetBackwardLabels());
+}
+
+void Serializator::SaveChainEdges(const TransportRouter::ChainEdges &chain_edges,
+                                  const TransportRouter::BusesById &buses_by_id) {
+    auto p_chain_edges = proto_catalogue_.mutable_router()->mutable_chain_edges();
+    p_chain_edges->set_first_edge_id(static_cast<uint32_t>(chain_edges.first_edge_id));
+    p_chain_edges->mutable_offsets()->Add(chain_edges.offsets.begin(), chain_edges.offsets.end());
+    for (const auto &weight : chain_edges.weights) {
+        *p_chain_edges->add_weights() = MakeProtoWeight(weight, buses_by_id);
     }
 }
 
@@ -288,19 +332,54 @@ void Serializator::LoadTransportRouter(const TransportCatalogue &catalogue,
     // загружаем данные об используемых остановках
     auto &p_router = proto_catalogue_.router();
     auto stops_count = p_router.stop_by_id_size();
+    // номера остановок маршрутизатора идут подряд с нуля
+    auto &stops_by_id = transport_router->GetStopsById();
+    stops_by_id.assign(static_cast<size_t>(stops_count), nullptr);
     for (auto i = 0; i < stops_count; ++i) {
         auto &p_stop_by_id = p_router.stop_by_id(i);
         auto stop = catalogue.GetStops().at(stop_name_by_id_.at(p_stop_by_id.stop_id()));
-        transport_router->GetStopsById().insert({p_stop_by_id.id(), stop});
+        stops_by_id.at(p_stop_by_id.id()) = stop;
         transport_router->GetIdsByStopName().insert({stop->name, p_stop_by_id.id()});
     }
 
-    // загружаем граф
+    // номера автобусов маршрутизатора - номера автобусов в базе
+    for (size_t id = 0; id < route_name_by_id_.size(); ++id) {
+        auto bus = catalogue.GetRoutes().at(route_name_by_id_.at(static_cast<int>(id)));
+        transport_router->GetBusesById().push_back(bus);
+        transport_router->GetIdsByBusName().insert({bus->name, static_cast<uint32_t>(id)});
+    }
+
+    // загружаем граф и пути его сжатых цепочек
     LoadGraph(catalogue, transport_router->GetGraph());
-    // создаём роутер и загружаем внуттреннее состояние
-    transport_router->GetRouter() =
-            std::make_unique<TransportRouter::Router>(transport_router->GetGraph(), false);
-    LoadRouter(catalogue, transport_router->GetRouter());
+    if (p_router.has_chain_edges()) {
+        LoadChainEdges(catalogue, transport_router->GetGraph(), transport_router->GetChainEdges());
+    }
+    if (routing_settings.engine == TransportRouter::Engine::DIJKSTRA
+            || routing_settings.engine == TransportRouter::Engine::A_STAR) {
+        // поиску Дейкстры и A* достаточно графа, оценка A* строится по каталогу
+        transport_router->GetDijkstraRouter() =
+                std::make_unique<TransportRouter::DijkstraRouter>(transport_router->GetGraph());
+    } else if (routing_settings.engine == TransportRouter::Engine::CONTRACTION_HIERARCHY) {
+        // иерархия восстанавливается из сохранённого порядка вершин и сокращений
+        LoadContractionHierarchy(transport_router->GetGraph(), transport_router->GetContractionHierarchy());
+    } else if (routing_settings.engine == TransportRouter::Engine::LAZY_ROWS) {
+        // строки таблицы маршрутов вычисляются по требованию, сохраняется только граф
+        transport_router->GetLazyRouter() = std::make_unique<TransportRouter::LazyRouter>(
+                transport_router->GetGraph(), routing_settings.lazy_row_limit);
+    } else if (routing_settings.engine == TransportRouter::Engine::RAPTOR) {
+        // RAPTOR строится по маршрутам каталога, это быстрее чтения таблиц
+        transport_router->GetRaptorRouter() = std::make_unique<transport_router::RaptorRouter>(
+                catalogue, transport_router->GetIdsByStopName(),
+                routing_settings.wait_time, routing_settings.velocity);
+    } else {
+        // создаём роутер и загружаем внуттреннее состояние
+        transport_router->GetRouter() =
+                std::make_unique<TransportRouter::Router>(transport_router->GetGraph(), false);
+        LoadRouter(catalogue, transport_router->GetRouter());
+    }
+    if (p_router.has_hub_labels()) {
+        LoadHubLabels(transport_router->GetGraph(), transport_router->GetHubLabels());
+    }
     // инициализируем маршрутизатор загруженными значениями
     transport_router->InternalInit();
 }
@@ -311,6 +390,13 @@ void Serializator::LoadTransportRouterSettings(TransportRouter::RoutingSettings
 
     routing_settings.wait_time = p_settings.wait_time();
     routing_settings.velocity = p_settings.velocity();
+    routing_settings.engine = MakeRoutingEngine(p_settings.engine());
+    routing_settings.route_cache_size = p_settings.route_cache_size();
+    routing_settings.lazy_row_limit = p_settings.lazy_row_limit();
+    routing_settings.graph_model = MakeGraphModel(p_settings.graph_model());
+    routing_settings.hub_labels = p_settings.hub_labels();
+    routing_settings.all_pairs_algorithm = MakeAllPairsAlgorithm(p_settings.all_pairs_algorithm());
+    routing_settings.compress_chains = p_settings.compress_chains();
 }
 
 
@@ -319,7 +405,7 @@ void Serializator::LoadGraph(const TransportCatalogue &catalogue, TransportRoute
     auto edge_count = p_graph.edges_size();
 
     for (auto i = 0; i < edge_count; ++i) {
-        graph::Edge<transport_router::RouteWeight> edge;
+        TransportRouter::GraphEdge edge;
         auto &p_edge = p_graph.edges(i);
         edge.from = p_edge.from();
         edge.to = p_edge.to();
@@ -337,6 +423,8 @@ void Serializator::LoadGraph(const TransportCatalogue &catalogue, TransportRoute
         }
         graph.GetIncidenceLists().push_back(list);
     }
+    // маршрутизаторы обходят граф в сжатом представлении
+    graph.Freeze();
 }
 
 
@@ -345,32 +433,86 @@ void Serializator::LoadRouter(const TransportCatalogue &catalogue,
     auto &p_router = proto_catalogue_.router().router();
     auto &routes_internal_data = router->GetRoutesInternalData();
 
-    auto routes_internal_data_count = p_router.routes_internal_data_size();
-
-    for (int i = 0; i < routes_internal_data_count; ++i) {
-        auto &p_internal_data = p_router.routes_internal_data(i);
-        auto internal_data_count = p_internal_data.routes_internal_data_size();
-        for (int j = 0; j < internal_data_count; ++j) {
-            auto &p_optional_data = p_internal_data.routes_internal_data(j);
-            if (p_optional_data.optional_route_internal_data_case() ==
-            graph_serialize::OptionalRouteInternalData::kRouteInternalData) {
-                TransportRouter::Router::RouteInternalData data;
-                auto &p_data = p_optional_data.route_internal_data();
-                data.weight.total_time = p_data.total_time();
-                if (p_data.optional_prev_edge_case() ==
-                graph_serialize::RouteInternalData::kPrevEdge) {
-                    data.prev_edge = p_data.prev_edge();
-                } else {
-                    data.prev_edge = std::nullopt;
-                }
-                routes_internal_data[i][j] = std::move(data);
-            } else {
-                routes_internal_data[i][j] = std::nullopt;
-            }
-        }
+    auto &weights = routes_internal_data.GetWeights();
+    auto &prev_edges = routes_internal_data.GetPrevEdges();
+    if (static_cast<size_t>(p_router.weights_size()) != weights.size() ||
+        static_cast<size_t>(p_router.prev_edges_size()) != prev_edges.size()) {
+        throw std::invalid_argument("Serialized routes table does not match the graph");
+    }
+    std::copy(p_router.weights().begin(), p_router.weights().end(), weights.begin());
+    std::copy(p_router.prev_edges().begin(), p_router.prev_edges().end(), prev_edges.begin());
+}
+
+void Serializator::LoadContractionHierarchy(const TransportRouter::Graph &graph,
+                                            std::unique_ptr<TransportRouter::ContractionHierarchy> &hierarchy) {
+    auto &p_hierarchy = proto_catalogue_.router().contraction_hierarchy();
+
+    std::vector<size_t> ranks(p_hierarchy.ranks().begin(), p_hierarchy.ranks().end());
+
+    std::vector<TransportRouter::ContractionHierarchy::Shortcut> shortcuts;
+    shortcuts.reserve(p_hierarchy.shortcuts_size());
+    for (auto &p_shortcut : p_hierarchy.shortcuts()) {
+        TransportRouter::ContractionHierarchy::Shortcut shortcut;
+        shortcut.from = p_shortcut.from();
+        shortcut.to = p_shortcut.to();
+        shortcut.weight.total_time = p_shortcut.total_time();
+        shortcut.first = p_shortcut.first();
+        shortcut.second = p_shortcut.second();
+        shortcuts.push_back(shortcut);
+    }
+
+    hierarchy = std::make_unique<TransportRouter::ContractionHierarchy>(graph, std::move(ranks),
+                                                                        std::move(shortcuts));
+}
+
+void Serializator::LoadChainEdges(const TransportCatalogue &catalogue, const TransportRouter::Graph &graph,
+                                  TransportRouter::ChainEdges &chain_edges) {
+    auto &p_chain_edges = proto_catalogue_.router().chain_edges();
+    chain_edges.first_edge_id = p_chain_edges.first_edge_id();
+    chain_edges.offsets.assign(p_chain_edges.offsets().begin(), p_chain_edges.offsets().end());
+    chain_edges.weights.reserve(static_cast<size_t>(p_chain_edges.weights_size()));
+    for (const auto &p_weight : p_chain_edges.weights()) {
+        chain_edges.weights.push_back(MakeWeight(catalogue, p_weight));
+    }
+    // рёбра цепочек замыкают граф, а пути каждого ребра непусты и идут подряд
+    bool is_valid = !chain_edges.offsets.empty() && chain_edges.offsets.front() == 0
+            && chain_edges.offsets.back() == chain_edges.weights.size()
+            && chain_edges.first_edge_id + chain_edges.offsets.size() - 1 == graph.GetEdgeCount();
+    for (size_t i = 1; is_valid && i < chain_edges.offsets.size(); ++i) {
+        is_valid = chain_edges.offsets[i - 1] < chain_edges.offsets[i];
+    }
+    if (!is_valid) {
+        throw std::invalid_argument("Serialized chain edges do not match the graph");
+    }
+}
+
+void Serializator::LoadHubLabels(const TransportRouter::Graph &graph,
+                                 std::unique_ptr<TransportRouter::HubLabels> &hub_labels) {
+    auto &p_hub_labels = proto_catalogue_.router().hub_labels();
+    hub_labels = std::make_unique<TransportRouter::HubLabels>(MakeLabels(p_hub_labels.forward()),
+                                                              MakeLabels(p_hub_labels.backward()));
+    if (hub_labels->GetVertexCount() != graph.GetVertexCount()) {
+        throw std::invalid_argument("Serialized hub labels do not match the graph");
     }
 }
 
+graph_serialize::Labels Serializator::MakeProtoLabels(const TransportRouter::HubLabels::Labels &labels) {
+    graph_serialize::Labels p_labels;
+    p_labels.mutable_offsets()->Add(labels.offsets.begin(), labels.offsets.end());
+    p_labels.mutable_hubs()->Add(labels.hubs.begin(), labels.hubs.end());
+    p_labels.mutable_weights()->Add(labels.weights.begin(), labels.weights.end());
+    return p_labels;
+}
+
+transport_router::TransportRouter::HubLabels::Labels
+Serializator::MakeLabels(const graph_serialize::Labels &p_labels) {
+    TransportRouter::HubLabels::Labels labels;
+    labels.offsets.assign(p_labels.offsets().begin(), p_labels.offsets().end());
+    labels.hubs.assign(p_labels.hubs().begin(), p_labels.hubs().end());
+    labels.weights.assign(p_labels.weights().begin(), p_labels.weights().end());
+    return labels;
+}
+
 transport_catalogue_serialize::Coordinates
 Serializator::MakeProtoCoordinates(const geo::Coordinates &coordinates) {
     transport_catalogue_serialize::Coordinates p_coordinates;
@@ -423,6 +565,88 @@ Serializator::MakeRouteType(transport_catalogue_serialize::RouteType p_route_typ
     return type;
 }
 
+transport_router_serialize::RoutingEngine
+Serializator::MakeProtoRoutingEngine(TransportRouter::Engine engine) {
+    using ProtoRoutingEngine = transport_router_serialize::RoutingEngine;
+    ProtoRoutingEngine p_engine;
+    switch (engine) {
+    case TransportRouter::Engine::DIJKSTRA :
+        p_engine = ProtoRoutingEngine::DIJKSTRA;
+        break;
+    case TransportRouter::Engine::CONTRACTION_HIERARCHY :
+        p_engine = ProtoRoutingEngine::CONTRACTION_HIERARCHY;
+        break;
+    case TransportRouter::Engine::A_STAR :
+        p_engine = ProtoRoutingEngine::A_STAR;
+        break;
+    case TransportRouter::Engine::RAPTOR :
+        p_engine = ProtoRoutingEngine::RAPTOR;
+        break;
+    case TransportRouter::Engine::LAZY_ROWS :
+        p_engine = ProtoRoutingEngine::LAZY_ROWS;
+        break;
+    default:
+        p_engine = ProtoRoutingEngine::ALL_PAIRS;
+        break;
+    }
+    return p_engine;
+}
+
+transport_router::TransportRouter::Engine
+Serializator::MakeRoutingEngine(transport_router_serialize::RoutingEngine p_engine) {
+    using ProtoRoutingEngine = transport_router_serialize::RoutingEngine;
+    TransportRouter::Engine engine;
+    switch (p_engine) {
+    case ProtoRoutingEngine::DIJKSTRA :
+        engine = TransportRouter::Engine::DIJKSTRA;
+        break;
+    case ProtoRoutingEngine::CONTRACTION_HIERARCHY :
+        engine = TransportRouter::Engine::CONTRACTION_HIERARCHY;
+        break;
+    case ProtoRoutingEngine::A_STAR :
+        engine = TransportRouter::Engine::A_STAR;
+        break;
+    case ProtoRoutingEngine::RAPTOR :
+        engine = TransportRouter::Engine::RAPTOR;
+        break;
+    case ProtoRoutingEngine::LAZY_ROWS :
+        engine = TransportRouter::Engine::LAZY_ROWS;
+        break;
+    default:
+        engine = TransportRouter::Engine::ALL_PAIRS;
+        break;
+    }
+    return engine;
+}
+
+transport_router_serialize::GraphModel
+Serializator::MakeProtoGraphModel(TransportRouter::GraphModel graph_model) {
+    using ProtoGraphModel = transport_router_serialize::GraphModel;
+    return graph_model == TransportRouter::GraphModel::ON_BOARD ? ProtoGraphModel::ON_BOARD
+                                                                : ProtoGraphModel::STOP_PAIRS;
+}
+
+transport_router::TransportRouter::GraphModel
+Serializator::MakeGraphModel(transport_router_serialize::GraphModel p_graph_model) {
+    using ProtoGraphModel = transport_router_serialize::GraphModel;
+    return p_graph_model == ProtoGraphModel::ON_BOARD ? TransportRouter::GraphModel::ON_BOARD
+                                                      : TransportRouter::GraphModel::STOP_PAIRS;
+}
+
+transport_router_serialize::AllPairsAlgorithm
+Serializator::MakeProtoAllPairsAlgorithm(TransportRouter::Router::Algorithm algorithm) {
+    using ProtoAllPairsAlgorithm = transport_router_serialize::AllPairsAlgorithm;
+    return algorithm == TransportRouter::Router::Algorithm::DIJKSTRA ? ProtoAllPairsAlgorithm::PER_SOURCE_DIJKSTRA
+                                                                     : ProtoAllPairsAlgorithm::FLOYD_WARSHALL;
+}
+
+transport_router::TransportRouter::Router::Algorithm
+Serializator::MakeAllPairsAlgorithm(transport_router_serialize::AllPairsAlgorithm p_algorithm) {
+    using ProtoAllPairsAlgorithm = transport_router_serialize::AllPairsAlgorithm;
+    return p_algorithm == ProtoAllPairsAlgorithm::PER_SOURCE_DIJKSTRA ? TransportRouter::Router::Algorithm::DIJKSTRA
+                                                                      : TransportRouter::Router::Algorithm::BLOCKED;
+}
+
 svg_serialize::Point
 Serializator::MakeProtoPoint(const svg::Point &point) {
     svg_serialize::Point result;
@@ -489,9 +713,11 @@ Serializator::MakeColor(const svg_serialize::Color &p_color) {
 }
 
 graph_serialize::RouteWeight
-Serializator::MakeProtoWeight(const transport_router::RouteWeight &weight) const {
+Serializator::MakeProtoWeight(const transport_router::RouteWeight &weight,
+                              const TransportRouter::BusesById &buses_by_id) const {
     graph_serialize::RouteWeight p_weight;
-    p_weight.set_bus_id(route_id_by_name_.at(weight.bus_name));
+    // номер автобуса в маршрутизаторе переводится в номер автобуса в базе
+    p_weight.set_bus_id(route_id_by_name_.at(buses_by_id.at(weight.bus_id)->name));
     p_weight.set_span_count(weight.span_count);
     p_weight.set_total_time(weight.total_time);
     return p_weight;
@@ -502,9 +728,12 @@ Serializator::MakeWeight(const TransportCatalogue &catalogue,
                          const graph_serialize::RouteWeight &p_weight) const {
     transport_router::RouteWeight weight;
 
-    auto route_name = catalogue.GetRoutes().at(route_name_by_id_.at(p_weight.bus_id()));
-    weight.bus_name = route_name->name;
-    weight.span_count = p_weight.span_count();
+    // номера автобусов маршрутизатора при загрузке совпадают с номерами в базе
+    if (p_weight.bus_id() >= catalogue.GetRoutes().size()) {
+        throw std::out_of_range("Bus id is out of range");
+    }
+    weight.bus_id = p_weight.bus_id();
+    weight.span_count = static_cast<uint16_t>(p_weight.span_count());
     weight.total_time = p_weight.total_time();
     return weight;
 }
@@ -64,25 +64,47 @@ private:
     void SaveTransportRouterSettings(const TransportRouter::RoutingSettings &routing_settings);
     void LoadTransportRouterSettings(TransportRouter::RoutingSettings &routing_settings) const;
 
-    void SaveGraph(const TransportRouter::Graph &graph);
+    void SaveGraph(const TransportRouter::Graph &graph, const TransportRouter::BusesById &buses_by_id);
     void LoadGraph(const TransportCatalogue &catalogue, TransportRouter::Graph &graph);
 
     void SaveRouter(const std::unique_ptr<TransportRouter::Router> &router);
     void LoadRouter(const TransportCatalogue &catalogue, std::unique_ptr<TransportRouter::Router> &router);
 
+    void SaveContractionHierarchy(const TransportRouter::ContractionHierarchy &hierarchy);
+    void LoadContractionHierarchy(const TransportRouter::Graph &graph,
+                                  std::unique_ptr<TransportRouter::ContractionHierarchy> &hierarchy);
+
+    void SaveChainEdges(const TransportRouter::ChainEdges &chain_edges, const TransportRouter::BusesById &buses_by_id);
+    void LoadChainEdges(const TransportCatalogue &catalogue, const TransportRouter::Graph &graph,
+                        TransportRouter::ChainEdges &chain_edges);
+
+    void SaveHubLabels(const TransportRouter::HubLabels &hub_labels);
+    void LoadHubLabels(const TransportRouter::Graph &graph, std::unique_ptr<TransportRouter::HubLabels> &hub_labels);
+
     static transport_catalogue_serialize::Coordinates MakeProtoCoordinates(const geo::Coordinates &coordinates);
     static geo::Coordinates MakeCoordinates(const transport_catalogue_serialize::Coordinates &p_coordinates);
 
     static transport_catalogue_serialize::RouteType MakeProtoRouteType(domain::RouteType route_type);
     static domain::RouteType MakeRouteType(transport_catalogue_serialize::RouteType p_route_type);
 
+    static transport_router_serialize::RoutingEngine MakeProtoRoutingEngine(TransportRouter::Engine engine);
+    static TransportRouter::Engine MakeRoutingEngine(transport_router_serialize::RoutingEngine p_engine);
+    static transport_router_serialize::GraphModel MakeProtoGraphModel(TransportRouter::GraphModel graph_model);
+    static TransportRouter::GraphModel MakeGraphModel(transport_router_serialize::GraphModel p_graph_model);
+    static transport_router_serialize::AllPairsAlgorithm MakeProtoAllPairsAlgorithm(TransportRouter::Router::Algorithm algorithm);
+    static TransportRouter::Router::Algorithm MakeAllPairsAlgorithm(transport_router_serialize::AllPairsAlgorithm p_algorithm);
+
+    static graph_serialize::Labels MakeProtoLabels(const TransportRouter::HubLabels::Labels &labels);
+    static TransportRouter::HubLabels::Labels MakeLabels(const graph_serialize::Labels &p_labels);
+
     static svg_serialize::Point MakeProtoPoint(const svg::Point &point);
     static svg::Point MakePoint(const svg_serialize::Point &p_point);
 
     static svg_serialize::Color MakeProtoColor(const svg::Color &color);
     static svg::Color MakeColor(const svg_serialize::Color &p_color);
 
-    graph_serialize::RouteWeight MakeProtoWeight(const transport_router::RouteWeight &weight) const;
+    graph_serialize::RouteWeight MakeProtoWeight(const transport_router::RouteWeight &weight,
+                                                 const TransportRouter::BusesById &buses_by_id) const;
     transport_router::RouteWeight MakeWeight(const TransportCatalogue &catalogue,
                                              const graph_serialize::RouteWeight &p_weight) const;
 
@@ -0,0 +1,104 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace concurrency {
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    // один из потоков - вызывающий
+    workers_.reserve(thread_count - 1);
+    for (size_t i = 1; i < thread_count; ++i) {
+        workers_.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex_);
+        stopped_ = true;
+    }
+    task_ready_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::GetThreadCount() const {
+    return workers_.size() + 1;
+}
+
+void ThreadPool::Run(size_t count, std::function<void(size_t)> task) {
+    std::lock_guard run_lock(run_mutex_);
+    {
+        std::lock_guard lock(mutex_);
+        task_ = std::move(task);
+        task_count_ = count;
+        next_index_ = 0;
+        finished_count_ = 0;
+        exception_ = nullptr;
+        ++generation_;
+    }
+    task_ready_.notify_all();
+
+    ProcessTasks();
+
+    // ждём не только завершения задач, но и выхода всех потоков из серии,
+    // чтобы следующая серия не пересеклась с текущей
+    std::unique_lock lock(mutex_);
+    task_done_.wait(lock, [this] { return finished_count_ == task_count_ && active_workers_ == 0; });
+    task_ = nullptr;
+    if (exception_) {
+        std::rethrow_exception(exception_);
+    }
+}
+
+void ThreadPool::WorkerLoop() {
+    size_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex_);
+            task_ready_.wait(lock, [&] { return stopped_ || generation_ != seen_generation; });
+            if (stopped_) {
+                return;
+            }
+            seen_generation = generation_;
+            // поток мог проснуться уже после завершения серии: её задачи разобраны,
+            // а task_ и task_count_ может перезаписывать следующий Run.
+            // Пока в серии есть неразобранные задачи, Run ждёт выхода присоединившихся потоков
+            if (next_index_ >= task_count_) {
+                continue;
+            }
+            ++active_workers_;
+        }
+        ProcessTasks();
+        {
+            std::lock_guard lock(mutex_);
+            --active_workers_;
+        }
+        task_done_.notify_all();
+    }
+}
+
+void ThreadPool::ProcessTasks() {
+    size_t processed_count = 0;
+    for (size_t index = next_index_++; index < task_count_; index = next_index_++) {
+        try {
+            task_(index);
+        } catch (...) {
+            std::lock_guard lock(mutex_);
+            if (!exception_) {
+                exception_ = std::current_exception();
+            }
+        }
+        ++processed_count;
+    }
+    if (processed_count > 0) {
+        std::lock_guard lock(mutex_);
+        finished_count_ += processed_count;
+    }
+}
+
+} // namespace concurrency
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace concurrency {
+
+// Пул потоков для параллельной обработки независимых задач с индексами [0, count).
+// Задачи раздаются динамически через общий счётчик, поэтому неравномерные по
+// времени задачи распределяются между потоками автоматически.
+// Вызывающий поток тоже выполняет задачи и ждёт завершения всех.
+// Серии из разных потоков выполняются пулом по очереди.
+class ThreadPool final {
+public:
+    // thread_count = 0 - по числу аппаратных потоков
+    explicit ThreadPool(size_t thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // общее число потоков, включая вызывающий
+    size_t GetThreadCount() const;
+
+    // вызывает func(index) для всех index из [0, count) и ждёт завершения
+    // первое выброшенное задачей исключение пробрасывается вызывающему
+    template <typename Func>
+    void ParallelFor(size_t count, Func&& func) {
+        if (count == 0) {
+            return;
+        }
+        if (workers_.empty() || count == 1) {
+            for (size_t index = 0; index < count; ++index) {
+                func(index);
+            }
+            return;
+        }
+        Run(count, std::function<void(size_t)>(std::forward<Func>(func)));
+    }
+
+private:
+    void Run(size_t count, std::function<void(size_t)> task);
+    void WorkerLoop();
+    // выполняет задачи текущей серии, пока они не закончатся
+    void ProcessTasks();
+
+    std::vector<std::thread> workers_;
+
+    // удерживается вызывающим на всё время серии
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable task_ready_;
+    std::condition_variable task_done_;
+
+    std::function<void(size_t)> task_;
+    size_t task_count_ = 0;
+    std::atomic<size_t> next_index_ = 0;
+    size_t finished_count_ = 0;
+    size_t active_workers_ = 0;
+    size_t generation_ = 0;
+    bool stopped_ = false;
+    std::exception_ptr exception_;
+};
+
+} // namespace concurrency
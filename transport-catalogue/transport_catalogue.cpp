@@ -10,9 +10,11 @@ using namespace std;
 namespace transport_catalogue {
 
 void TransportCatalogue::AddBus(domain::Bus route) noexcept {
+    UpdateRouteDistances(route);
     bus_stops_.push_back(move(route));
     string_view route_name = bus_stops_.back().name;
     bus_by_name_.insert({route_name, &bus_stops_.back()});
+    owned_bus_by_name_.insert({route_name, &bus_stops_.back()});
     for (auto stop : bus_stops_.back().stops) {
         buses_by_stop_name_[stop->name].insert(route_name);
     }
@@ -50,6 +52,47 @@ void TransportCatalogue::SetDistanceStops(const std::string &stop_from, const st
     auto Stop_from = GetStop(stop_from);
     auto Stop_to = GetStop(stop_to);
     stops_to_dist_[Stop_from->name][Stop_to->name] = distance;
+    // перегон между остановками есть только у автобусов, проходящих через обе
+    if (auto buses = buses_by_stop_name_.find(Stop_from->name); buses != buses_by_stop_name_.end()) {
+        for (auto bus_name : buses->second) {
+            UpdateRouteDistances(*owned_bus_by_name_.at(bus_name));
+        }
+    }
+}
+
+optional<int> TransportCatalogue::FindDistance(string_view stop_from, string_view stop_to) const {
+    if (auto from = stops_to_dist_.find(stop_from); from != stops_to_dist_.end()) {
+        if (auto to = from->second.find(stop_to); to != from->second.end()) {
+            return to->second;
+        }
+    }
+    if (auto from = stops_to_dist_.find(stop_to); from != stops_to_dist_.end()) {
+        if (auto to = from->second.find(stop_from); to != from->second.end()) {
+            return to->second;
+        }
+    }
+    return nullopt;
+}
+
+void TransportCatalogue::UpdateRouteDistances(domain::Bus& bus) const {
+    const size_t stop_count = bus.stops.size();
+    bus.distances.assign(stop_count, 0);
+    bus.back_distances.clear();
+    for (size_t i = 1; i < stop_count; ++i) {
+        auto distance = FindDistance(bus.stops[i - 1]->name, bus.stops[i]->name);
+        if (!distance) {
+            bus.distances.clear();
+            return;
+        }
+        bus.distances[i] = bus.distances[i - 1] + *distance;
+    }
+    if (bus.route_type == domain::RouteType::LINEAR && stop_count > 0) {
+        bus.back_distances.assign(stop_count, 0);
+        for (size_t i = stop_count - 1; i > 0; --i) {
+            // на обратном пути перегон i -> i - 1 может быть другой длины
+            bus.back_distances[i - 1] = bus.back_distances[i] + *FindDistance(bus.stops[i]->name, bus.stops[i - 1]->name);
+        }
+    }
 }
 
 const domain::Stop* TransportCatalogue::GetStop(const string &stop_name) const {
@@ -100,18 +143,12 @@ int TransportCatalogue::GetForwardDistance(const std::string &stop_from,
 
 int TransportCatalogue::GetDistance(const std::string &stop_from, 
                                     const std::string &stop_to) const {
-    int result = 0;
-    try {
-        result = GetForwardDistance(stop_from, stop_to);
-    } catch (std::out_of_range&) {
-        try {
-            result = GetForwardDistance(stop_to, stop_from);
-        } catch (std::out_of_range&) {
-            throw std::out_of_range("No information about distance between stops "s
-                                                + stop_from + " and "s + stop_to);
-        }
+    auto result = FindDistance(stop_from, stop_to);
+    if (!result) {
+        throw std::out_of_range("No information about distance between stops "s
+                                            + stop_from + " and "s + stop_to);
     }
-    return result;
+    return *result;
 }
 
 const std::unordered_map<string_view, const domain::Bus*>
@@ -136,7 +173,12 @@ const std::unordered_map<string_view, std::unordered_map<string_view, int> >
 
 int TransportCatalogue::CalculateRealRouteLength(const domain::Bus *route) const {
     int result = 0;
-    if (route != nullptr) {
+    if (route != nullptr && route->HasDistances()) {
+        result = route->distances.back();
+        if (route->route_type == domain::RouteType::LINEAR) {
+            result += route->back_distances.front();
+        }
+    } else if (route != nullptr) {
         for (auto iter1 = route->stops.begin(), iter2 = iter1+1;
              iter2 < route->stops.end();
              ++iter1, ++iter2) {
@@ -25,7 +25,9 @@ public:
     // добавляет остановку в каталог
     void AddStop(const std::string &stop_name, geo::Coordinates coordinate);
     
-    // Добавляет расстояние между остановками
+    // Добавляет расстояние между остановками.
+    // Пройденные расстояния автобусов через stop_from пересчитываются, поэтому
+    // расстояния выгоднее добавлять до автобусов
     void SetDistanceStops(const std::string &stop_from, const std::string &stop_to, int distance);
     // Возвращет расстояние между остановками в прям или обратном направлении
     int GetDistance(const std::string& stop_from, const std::string& stop_to) const;
@@ -54,6 +56,10 @@ private:
     const domain::Bus* GetBus(const std::string& route_name) const;
     // Возвращает расстояние между остановками в прямом направлении
     int GetForwardDistance(const std::string& stop_from, const std::string& stop_to) const;
+    // Расстояние в прямом или обратном направлении, nullopt - неизвестно
+    std::optional<int> FindDistance(std::string_view stop_from, std::string_view stop_to) const;
+    // Заполняет пройденные расстояния автобуса (или очищает, если известны не все)
+    void UpdateRouteDistances(domain::Bus& bus) const;
     // Считает общее расстояние по маршруту
     int CalculateRealRouteLength(const domain::Bus* bus) const;
 
@@ -65,6 +71,8 @@ private:
     // Автобусы
     std::deque<domain::Bus> bus_stops_;
     std::unordered_map<std::string_view, const domain::Bus*> bus_by_name_;
+    // те же автобусы для пересчёта их расстояний внутри каталога
+    std::unordered_map<std::string_view, domain::Bus*> owned_bus_by_name_;
     // Расстояния между остановками
     std::unordered_map<std::string_view, std::unordered_map<std::string_view, int>> stops_to_dist_;
 
@@ -1,44 +1,467 @@
 #include "transport_router.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals;
+
 namespace transport_router {
 
+namespace {
+
+// разносит младшие 32 бита value по чётным битам результата
+uint64_t SpreadBits(uint64_t value) {
+    value &= 0xFFFFFFFFull;
+    value = (value | (value << 16)) & 0x0000FFFF0000FFFFull;
+    value = (value | (value << 8)) & 0x00FF00FF00FF00FFull;
+    value = (value | (value << 4)) & 0x0F0F0F0F0F0F0F0Full;
+    value = (value | (value << 2)) & 0x3333333333333333ull;
+    value = (value | (value << 1)) & 0x5555555555555555ull;
+    return value;
+}
+
+// номер ячейки координаты в сетке из 2^32 ячеек на отрезке [min, max]
+uint64_t ComputeCell(double value, double min, double max) {
+    if (!(max > min)) {
+        return 0;
+    }
+    constexpr double CELL_COUNT = 4294967295.0;
+    return static_cast<uint64_t>(std::clamp((value - min) / (max - min), 0.0, 1.0) * CELL_COUNT);
+}
+
+} // namespace
+
 TransportRouter::TransportRouter(const transport_catalogue::TransportCatalogue &catalogue,
                                  const RoutingSettings &settings)
-                                : catalogue_(catalogue), settings_(settings) {
+                                : catalogue_(catalogue), settings_(settings)
+                                , thread_pool_(std::make_unique<concurrency::ThreadPool>()) {
+    if (settings_.route_cache_size > 0) {
+        route_cache_ = std::make_unique<RouteCache>(settings_.route_cache_size);
+    }
 }
 
 void TransportRouter::InitRouter() {
     if (!is_initialized_) {
-        graph::DirectedWeightedGraph<RouteWeight>graph(CountStops());
+        const size_t stop_count = CountStops();
+        CountBuses();
+        // в модели ON_BOARD вершины "в автобусе" идут после вершин остановок
+        const bool has_on_board_vertices = settings_.graph_model == GraphModel::ON_BOARD
+                && settings_.engine != Engine::RAPTOR;
+        Graph graph(
+                stop_count + (has_on_board_vertices ? CountOnBoardVertices() : 0));
         graph_ = std::move(graph);
+        if (settings_.engine == Engine::RAPTOR) {
+            graph_.Freeze();
+            // RAPTOR работает по маршрутам автобусов, рёбра графа ему не нужны
+            raptor_router_ = std::make_unique<RaptorRouter>(catalogue_, id_by_stop_name_,
+                                                            settings_.wait_time, settings_.velocity);
+            is_initialized_ = true;
+            return;
+        }
         BuildEdges();
-        router_ = std::make_unique<graph::Router<RouteWeight>>(graph_);
+        if (has_on_board_vertices && settings_.compress_chains) {
+            CompressChains();
+        }
+        // все алгоритмы обходят граф в сжатом представлении
+        graph_.Freeze();
+        switch (settings_.engine) {
+        case Engine::DIJKSTRA :
+            dijkstra_router_ = std::make_unique<DijkstraRouter>(graph_);
+            break;
+        case Engine::A_STAR :
+            dijkstra_router_ = std::make_unique<DijkstraRouter>(graph_);
+            PrepareHeuristic();
+            break;
+        case Engine::CONTRACTION_HIERARCHY :
+            contraction_hierarchy_ = std::make_unique<ContractionHierarchy>(graph_);
+            break;
+        case Engine::LAZY_ROWS :
+            lazy_router_ = std::make_unique<LazyRouter>(graph_, settings_.lazy_row_limit);
+            break;
+        default:
+            router_ = std::make_unique<Router>(graph_, true, settings_.all_pairs_algorithm);
+            break;
+        }
+        if (settings_.hub_labels) {
+            hub_labels_ = std::make_unique<HubLabels>(graph_);
+        }
+        k_shortest_paths_ = std::make_unique<KShortestPaths>(graph_);
         is_initialized_ = true;
     }
 }
 
+void TransportRouter::AddBus(std::string_view bus_name) {
+    if (!is_initialized_) {
+        // автобус попадёт в граф при построении
+        return;
+    }
+    const domain::Bus* bus = catalogue_.GetRoutes().at(bus_name);
+    bool has_new_stops = catalogue_.GetStops().size() != stops_by_id_.size();
+    for (const auto* stop : bus->stops) {
+        has_new_stops = has_new_stops || id_by_stop_name_.count(stop->name) == 0;
+    }
+    const bool adds_vertices = settings_.graph_model == GraphModel::ON_BOARD && settings_.engine != Engine::RAPTOR;
+    // автобус с уже известным именем изменён, а не добавлен
+    const bool is_modified = id_by_bus_name_.count(bus->name) > 0;
+    if (has_new_stops || adds_vertices || is_modified) {
+        Rebuild();
+        return;
+    }
+
+    ResetRouteCaches();
+    if (settings_.engine == Engine::RAPTOR) {
+        AddBusId(bus);
+        raptor_router_ = std::make_unique<RaptorRouter>(catalogue_, id_by_stop_name_,
+                                                        settings_.wait_time, settings_.velocity);
+        return;
+    }
+    AddBusId(bus);
+    const graph::EdgeId first_edge_id = graph_.GetEdgeCount();
+    Edges edges;
+    BuildBusEdges(bus, edges);
+    for (const auto& edge : edges) {
+        graph_.AddEdge(edge);
+    }
+    graph_.Freeze();
+    switch (settings_.engine) {
+    case Engine::DIJKSTRA :
+        dijkstra_router_ = std::make_unique<DijkstraRouter>(graph_);
+        break;
+    case Engine::A_STAR :
+        dijkstra_router_ = std::make_unique<DijkstraRouter>(graph_);
+        PrepareHeuristic();
+        break;
+    case Engine::CONTRACTION_HIERARCHY :
+        // сжатие зависит от всех рёбер, иерархия строится заново
+        contraction_hierarchy_ = std::make_unique<ContractionHierarchy>(graph_);
+        break;
+    case Engine::LAZY_ROWS :
+        lazy_router_ = std::make_unique<LazyRouter>(graph_, settings_.lazy_row_limit);
+        break;
+    default:
+        router_->AddEdges(first_edge_id);
+        break;
+    }
+    if (hub_labels_) {
+        // новые рёбра могут сократить пути, не проходящие через опорные вершины их концов
+        hub_labels_ = std::make_unique<HubLabels>(graph_);
+    }
+    k_shortest_paths_ = std::make_unique<KShortestPaths>(graph_);
+}
+
+void TransportRouter::Rebuild() {
+    is_initialized_ = false;
+    stops_by_id_.clear();
+    id_by_stop_name_.clear();
+    buses_by_id_.clear();
+    id_by_bus_name_.clear();
+    router_.reset();
+    dijkstra_router_.reset();
+    contraction_hierarchy_.reset();
+    raptor_router_.reset();
+    lazy_router_.reset();
+    hub_labels_.reset();
+    k_shortest_paths_.reset();
+    chain_edges_ = ChainEdges{};
+    ResetRouteCaches();
+    InitRouter();
+}
+
+void TransportRouter::ResetRouteCaches() {
+    if (route_cache_) {
+        route_cache_ = std::make_unique<RouteCache>(settings_.route_cache_size);
+    }
+}
+
+void TransportRouter::CheckInitialized() const {
+    if (!is_initialized_) {
+        throw std::logic_error("Transport router should be built before queries");
+    }
+}
+
+TransportRouter::QueryScratch& TransportRouter::GetThreadScratch() {
+    thread_local QueryScratch scratch;
+    return scratch;
+}
+
 std::optional<TransportRouter::TransportRoute>
-TransportRouter::BuildRoute(const std::string &from, const std::string &to) {
+TransportRouter::BuildRoute(const std::string &from, const std::string &to) const {
+    return BuildRoute(from, to, GetThreadScratch());
+}
+
+std::optional<TransportRouter::TransportRoute>
+TransportRouter::BuildRoute(const std::string &from, const std::string &to, QueryScratch& scratch) const {
+    CheckInitialized();
     if (from == to) {
         return TransportRoute{};
     }
-    InitRouter();
     auto from_id = id_by_stop_name_.at(from);
     auto to_id = id_by_stop_name_.at(to);
-    auto route = router_->BuildRoute(from_id, to_id);
+
+    if (route_cache_) {
+        if (auto cached_route = route_cache_->Get({from_id, to_id})) {
+            return std::move(*cached_route);
+        }
+    }
+    auto result = settings_.engine == Engine::RAPTOR
+            ? BuildRaptorRoute(from_id, to_id, scratch)
+            : BuildGraphRoute(from_id, to_id, scratch);
+    if (route_cache_) {
+        route_cache_->Put({from_id, to_id}, result);
+    }
+    return result;
+}
+
+std::optional<double> TransportRouter::GetRouteTime(const std::string &from, const std::string &to) const {
+    CheckInitialized();
+    if (from == to) {
+        return 0.0;
+    }
+    if (hub_labels_) {
+        return hub_labels_->ComputeRouteWeight(id_by_stop_name_.at(from), id_by_stop_name_.at(to));
+    }
+    auto route = BuildRoute(from, to);
     if (!route) {
         return std::nullopt;
     }
+    double result = 0;
+    for (const auto& edge : *route) {
+        result += edge.total_time;
+    }
+    return result;
+}
+
+TransportRouter::Isochrone TransportRouter::BuildIsochrone(const std::string& from, double max_time) const {
+    CheckInitialized();
+    const auto from_id = id_by_stop_name_.at(from);
+
+    Isochrone result;
+    if (settings_.engine == Engine::RAPTOR) {
+        // графа нет - время до всех остановок дают раунды RAPTOR
+        QueryScratch& scratch = GetThreadScratch();
+        const std::vector<double>& arrivals = scratch.arrivals;
+        raptor_router_->ComputeArrivals(from_id, scratch.arrivals, scratch.raptor);
+        for (graph::VertexId stop_id = 0; stop_id < arrivals.size(); ++stop_id) {
+            if (arrivals[stop_id] <= max_time) {
+                result.push_back({stops_by_id_[stop_id]->name, arrivals[stop_id]});
+            }
+        }
+        std::stable_sort(result.begin(), result.end(), [](const StopTime& lhs, const StopTime& rhs) {
+            return lhs.time < rhs.time;
+        });
+        return result;
+    }
+
+    RouteWeight max_weight;
+    max_weight.total_time = max_time;
+    for (const auto& [vertex_id, weight] : graph::ComputeReachableVertices(graph_, from_id, max_weight)) {
+        // вершины "в автобусе" модели ON_BOARD остановками не являются
+        if (vertex_id < stops_by_id_.size()) {
+            result.push_back({stops_by_id_[vertex_id]->name, weight.total_time});
+        }
+    }
+    return result;
+}
+
+void TransportRouter::BuildTravelTimeMatrix(const std::vector<std::string>& origins,
+                                            const std::vector<std::string>& destinations,
+                                            const TravelTimesHandler& handler) const {
+    // строк в пачке на поток: достаточно для выравнивания нагрузки при небольшой памяти
+    constexpr size_t ROWS_PER_THREAD = 4;
+
+    CheckInitialized();
+    std::vector<graph::VertexId> origin_ids;
+    origin_ids.reserve(origins.size());
+    for (const auto& name : origins) {
+        origin_ids.push_back(id_by_stop_name_.at(name));
+    }
+    std::vector<graph::VertexId> destination_ids;
+    destination_ids.reserve(destinations.size());
+    for (const auto& name : destinations) {
+        destination_ids.push_back(id_by_stop_name_.at(name));
+    }
+
+    concurrency::ThreadPool& pool = *thread_pool_;
+    const size_t batch_size = pool.GetThreadCount() * ROWS_PER_THREAD;
+    std::vector<TravelTimes> batch(std::min(batch_size, origin_ids.size()));
+    for (size_t batch_begin = 0; batch_begin < origin_ids.size(); batch_begin += batch_size) {
+        const size_t batch_count = std::min(batch_size, origin_ids.size() - batch_begin);
+        pool.ParallelFor(batch_count, [&](size_t index) {
+            // у каждого потока пула свои рабочие буферы
+            ComputeTravelTimes(origin_ids[batch_begin + index], destination_ids, batch[index], GetThreadScratch());
+        });
+        for (size_t index = 0; index < batch_count; ++index) {
+            handler(batch_begin + index, batch[index]);
+        }
+    }
+}
+
+void TransportRouter::ComputeTravelTimes(graph::VertexId from, const std::vector<graph::VertexId>& destinations,
+                                         TravelTimes& times, QueryScratch& scratch) const {
+    times.resize(destinations.size());
+    if (router_) {
+        // строка готовой таблицы всех пар
+        const double* weights = router_->GetRoutesInternalData().GetWeights(from);
+        for (size_t i = 0; i < destinations.size(); ++i) {
+            const double weight = weights[destinations[i]];
+            times[i] = weight != Router::RoutesInternalData::UNREACHABLE ? std::optional<double>(weight)
+                                                                         : std::nullopt;
+        }
+        return;
+    }
+    if (hub_labels_) {
+        for (size_t i = 0; i < destinations.size(); ++i) {
+            times[i] = hub_labels_->ComputeRouteWeight(from, destinations[i]);
+        }
+        return;
+    }
+    if (raptor_router_) {
+        raptor_router_->ComputeArrivals(from, scratch.arrivals, scratch.raptor);
+        for (size_t i = 0; i < destinations.size(); ++i) {
+            const double arrival = scratch.arrivals[destinations[i]];
+            times[i] = std::isfinite(arrival) ? std::optional<double>(arrival) : std::nullopt;
+        }
+        return;
+    }
+    graph::ComputeTargetWeights(graph_, from, destinations, scratch.target_weights, scratch.target_search);
+    for (size_t i = 0; i < destinations.size(); ++i) {
+        const auto& weight = scratch.target_weights[i];
+        times[i] = weight ? std::optional<double>(weight->total_time) : std::nullopt;
+    }
+}
+
+std::vector<TransportRouter::TransportRoute>
+TransportRouter::BuildRoutes(const std::string &from, const std::string &to, size_t max_route_count) const {
+    return BuildRoutes(from, to, max_route_count, GetThreadScratch());
+}
+
+std::vector<TransportRouter::TransportRoute>
+TransportRouter::BuildRoutes(const std::string &from, const std::string &to, size_t max_route_count,
+                             QueryScratch& scratch) const {
+    std::vector<TransportRoute> result;
+    if (max_route_count == 0) {
+        return result;
+    }
+    if (from == to || settings_.engine == Engine::RAPTOR) {
+        if (auto route = BuildRoute(from, to, scratch)) {
+            result.push_back(std::move(*route));
+        }
+        return result;
+    }
+    CheckInitialized();
+    auto from_id = id_by_stop_name_.at(from);
+    auto to_id = id_by_stop_name_.at(to);
+
+    // маршруты с той же последовательностью автобусов (с другими пересадками) считаются одинаковыми
+    std::set<std::vector<uint32_t>> bus_sequences;
+    auto is_new_bus_sequence = [&](const Router::RouteInfo& route) {
+        std::vector<uint32_t> buses;
+        for (const auto edge_id : route.edges) {
+            const auto bus_id = graph_.GetEdge(edge_id).weight.bus_id;
+            if (buses.empty() || buses.back() != bus_id) {
+                buses.push_back(bus_id);
+            }
+        }
+        return bus_sequences.insert(std::move(buses)).second;
+    };
+    for (const auto& route : k_shortest_paths_->BuildRoutes(from_id, to_id, max_route_count, is_new_bus_sequence,
+                                                               scratch.k_shortest_paths)) {
+        result.push_back(MakeTransportRoute(route.edges));
+    }
+    return result;
+}
+
+std::optional<TransportRouter::TransportRoute>
+TransportRouter::BuildGraphRoute(graph::VertexId from, graph::VertexId to, QueryScratch& scratch) const {
+    if (!FindRoute(from, to, scratch)) {
+        return std::nullopt;
+    }
+    return MakeTransportRoute(scratch.route_edges);
+}
 
+TransportRouter::TransportRoute TransportRouter::MakeTransportRoute(const std::vector<graph::EdgeId>& edges) const {
+    const size_t stop_count = stops_by_id_.size();
     TransportRoute result;
-    for (auto edge_id : route->edges) {
+    // участков не больше, чем рёбер (ребро цепочки не проходит через остановки):
+    // одно выделение памяти на ответ
+    result.reserve(edges.size());
+    RouterEdge route_edge;
+    bool is_on_board = false;
+    // Шаг - исходное ребро графа. Посадка в модели ON_BOARD начинает участок, перегоны
+    // складываются в том же порядке, что и в весе ребра модели STOP_PAIRS, до высадки на остановку
+    auto add_step = [&](const GraphEdge& edge, const RouteWeight& weight, bool to_on_board) {
+        if (is_on_board) {
+            route_edge.total_time += weight.total_time;
+            route_edge.span_count += weight.span_count;
+        } else {
+            route_edge.bus_name = buses_by_id_[weight.bus_id]->name;
+            route_edge.stop_from = stops_by_id_[edge.from]->name;
+            route_edge.span_count = weight.span_count;
+            route_edge.total_time = weight.total_time;
+        }
+        is_on_board = to_on_board;
+        if (!is_on_board) {
+            route_edge.stop_to = stops_by_id_[edge.to]->name;
+            result.push_back(route_edge);
+        }
+    };
+    for (const auto edge_id : edges) {
         const auto &edge = graph_.GetEdge(edge_id);
+        if (!IsChainEdge(edge_id)) {
+            add_step(edge, edge.weight, edge.to >= stop_count);
+            continue;
+        }
+        // ребро цепочки раскрывается в рёбра пути: все, кроме последнего, ведут в удалённые вершины "в автобусе"
+        const size_t chain_index = edge_id - chain_edges_.first_edge_id;
+        const size_t last = chain_edges_.offsets[chain_index + 1] - 1;
+        for (size_t i = chain_edges_.offsets[chain_index]; i <= last; ++i) {
+            add_step(edge, chain_edges_.weights[i], i < last || edge.to >= stop_count);
+        }
+    }
+    return result;
+}
+
+std::optional<RouteWeight> TransportRouter::FindRoute(graph::VertexId from, graph::VertexId to,
+                                                      QueryScratch& scratch) const {
+    // маршрут собирается сразу в буфер вызывающего, его ёмкость сохраняется для следующих запросов
+    std::vector<graph::EdgeId>& edges = scratch.route_edges;
+    switch (settings_.engine) {
+    case Engine::DIJKSTRA :
+        return dijkstra_router_->BuildRoute(from, to, scratch.dijkstra, edges);
+    case Engine::A_STAR :
+        return dijkstra_router_->BuildRoute(from, to, [this, to](graph::VertexId vertex) {
+            return EstimateRouteWeight(vertex, to);
+        }, scratch.dijkstra, edges);
+    case Engine::CONTRACTION_HIERARCHY :
+        return contraction_hierarchy_->BuildRoute(from, to, scratch.hierarchy, edges);
+    case Engine::LAZY_ROWS :
+        return lazy_router_->BuildRoute(from, to, edges);
+    default:
+        return router_->BuildRoute(from, to, edges);
+    }
+}
+
+std::optional<TransportRouter::TransportRoute>
+TransportRouter::BuildRaptorRoute(graph::VertexId from, graph::VertexId to, QueryScratch& scratch) const {
+    auto journey = raptor_router_->BuildRoute(from, to, scratch.raptor);
+    if (!journey) {
+        return std::nullopt;
+    }
+
+    TransportRoute result;
+    result.reserve(journey->size());
+    for (const auto& leg : *journey) {
         RouterEdge route_edge;
-        route_edge.bus_name = edge.weight.bus_name;
-        route_edge.stop_from = stops_by_id_.at(edge.from)->name;
-        route_edge.stop_to = stops_by_id_.at(edge.to)->name;
-        route_edge.span_count = edge.weight.span_count;
-        route_edge.total_time = edge.weight.total_time;
+        route_edge.bus_name = leg.bus_name;
+        route_edge.stop_from = stops_by_id_[leg.from]->name;
+        route_edge.stop_to = stops_by_id_[leg.to]->name;
+        route_edge.span_count = leg.span_count;
+        route_edge.total_time = leg.time;
         result.push_back(route_edge);
     }
     return result;
@@ -53,9 +476,19 @@ TransportRouter::RoutingSettings& TransportRouter::GetSettings() {
 }
 
 void TransportRouter::InternalInit() {
+    if (settings_.engine == Engine::A_STAR) {
+        PrepareHeuristic();
+    }
+    if (settings_.engine != Engine::RAPTOR) {
+        k_shortest_paths_ = std::make_unique<KShortestPaths>(graph_);
+    }
     is_initialized_ = true;
 }
 
+bool TransportRouter::IsInitialized() const {
+    return is_initialized_;
+}
+
 TransportRouter::Graph& TransportRouter::GetGraph() {
     return graph_;
 }
@@ -70,6 +503,58 @@ const std::unique_ptr<TransportRouter::Router>& TransportRouter::GetRouter() con
     return router_;
 }
 
+std::unique_ptr<TransportRouter::DijkstraRouter>& TransportRouter::GetDijkstraRouter() {
+    return dijkstra_router_;
+}
+const std::unique_ptr<TransportRouter::DijkstraRouter>& TransportRouter::GetDijkstraRouter() const {
+    return dijkstra_router_;
+}
+
+std::unique_ptr<TransportRouter::ContractionHierarchy>& TransportRouter::GetContractionHierarchy() {
+    return contraction_hierarchy_;
+}
+const std::unique_ptr<TransportRouter::ContractionHierarchy>&
+TransportRouter::GetContractionHierarchy() const {
+    return contraction_hierarchy_;
+}
+
+std::unique_ptr<RaptorRouter>& TransportRouter::GetRaptorRouter() {
+    return raptor_router_;
+}
+const std::unique_ptr<RaptorRouter>& TransportRouter::GetRaptorRouter() const {
+    return raptor_router_;
+}
+
+std::unique_ptr<TransportRouter::HubLabels>& TransportRouter::GetHubLabels() {
+    return hub_labels_;
+}
+const std::unique_ptr<TransportRouter::HubLabels>& TransportRouter::GetHubLabels() const {
+    return hub_labels_;
+}
+
+TransportRouter::ChainEdges& TransportRouter::GetChainEdges() {
+    return chain_edges_;
+}
+const TransportRouter::ChainEdges& TransportRouter::GetChainEdges() const {
+    return chain_edges_;
+}
+
+bool TransportRouter::IsChainEdge(graph::EdgeId edge_id) const {
+    return edge_id >= chain_edges_.first_edge_id
+            && edge_id - chain_edges_.first_edge_id + 1 < chain_edges_.offsets.size();
+}
+
+const TransportRouter::RouteCache* TransportRouter::GetRouteCache() const {
+    return route_cache_.get();
+}
+
+std::unique_ptr<TransportRouter::LazyRouter>& TransportRouter::GetLazyRouter() {
+    return lazy_router_;
+}
+const std::unique_ptr<TransportRouter::LazyRouter>& TransportRouter::GetLazyRouter() const {
+    return lazy_router_;
+}
+
 TransportRouter::StopsById& TransportRouter::GetStopsById() {
     return stops_by_id_;
 }
@@ -84,60 +569,416 @@ const TransportRouter::IdsByStopName &TransportRouter::GetIdsByStopName() const
     return id_by_stop_name_;
 }
 
+TransportRouter::BusesById& TransportRouter::GetBusesById() {
+    return buses_by_id_;
+}
+const TransportRouter::BusesById& TransportRouter::GetBusesById() const {
+    return buses_by_id_;
+}
+
+TransportRouter::IdsByBusName& TransportRouter::GetIdsByBusName() {
+    return id_by_bus_name_;
+}
+const TransportRouter::IdsByBusName& TransportRouter::GetIdsByBusName() const {
+    return id_by_bus_name_;
+}
+
 void TransportRouter::BuildEdges() {
-    for (const auto& [route_name, route] : catalogue_.GetRoutes()) {
-        int stops_count = static_cast<int>(route->stops.size());
-        for(int i = 0; i < stops_count - 1; ++i) {
-            double route_time = settings_.wait_time;
-            double route_time_back = settings_.wait_time;
-            for(int j = i + 1; j < stops_count; ++j) {
-                graph::Edge<RouteWeight> edge = MakeEdge(route, i, j);
-                route_time += ComputeRouteTime(route, j - 1, j);
-                edge.weight.total_time = route_time;
-                graph_.AddEdge(edge);
-                if (route->route_type == domain::RouteType::LINEAR) {
-                    int i_back = stops_count - 1 - i;
-                    int j_back = stops_count - 1 - j;
-                    graph::Edge<RouteWeight> edge = MakeEdge(route, i_back, j_back);
-                    route_time_back += ComputeRouteTime(route, j_back + 1, j_back);
-                    edge.weight.total_time = route_time_back;
-                    graph_.AddEdge(edge);
+    const auto& routes = catalogue_.GetRoutes();
+    std::vector<const domain::Bus*> buses;
+    buses.reserve(routes.size());
+    for (const auto& [route_name, route] : routes) {
+        buses.push_back(route);
+    }
+    // вершины "в автобусе" нумеруются подряд в порядке автобусов
+    std::vector<graph::VertexId> first_vertices;
+    if (settings_.graph_model == GraphModel::ON_BOARD) {
+        first_vertices.reserve(buses.size());
+        graph::VertexId next_vertex = stops_by_id_.size();
+        for (const auto* bus : buses) {
+            first_vertices.push_back(next_vertex);
+            next_vertex += CountBusOnBoardVertices(bus);
+        }
+    }
+
+    std::vector<Edges> edges_by_bus(buses.size());
+    thread_pool_->ParallelFor(buses.size(), [&](size_t index) {
+        if (settings_.graph_model == GraphModel::ON_BOARD) {
+            BuildBusOnBoardEdges(buses[index], first_vertices[index], edges_by_bus[index]);
+        } else {
+            BuildBusEdges(buses[index], edges_by_bus[index]);
+        }
+    });
+
+    size_t edge_count = 0;
+    for (const auto& edges : edges_by_bus) {
+        edge_count += edges.size();
+    }
+    graph_.GetEdges().reserve(edge_count);
+    for (auto& edges : edges_by_bus) {
+        for (const auto& edge : edges) {
+            graph_.AddEdge(edge);
+        }
+        Edges().swap(edges);
+    }
+}
+
+void TransportRouter::BuildBusOnBoardEdges(const domain::Bus *route, graph::VertexId first_vertex,
+                                           Edges& edges) const {
+    const int stops_count = static_cast<int>(route->stops.size());
+    const uint32_t bus_id = id_by_bus_name_.at(route->name);
+    const int direction_count = route->route_type == domain::RouteType::LINEAR ? 2 : 1;
+    edges.reserve(CountBusOnBoardVertices(route) * 3);
+    for (int direction = 0; direction < direction_count; ++direction) {
+        // индекс остановки в маршруте для позиции в направлении движения
+        auto stop_index = [direction, stops_count](int position) {
+            return direction == 0 ? position : stops_count - 1 - position;
+        };
+        const graph::VertexId direction_first_vertex = first_vertex + static_cast<size_t>(direction * stops_count);
+        for (int position = 0; position < stops_count; ++position) {
+            // номера вершин меньше числа вершин графа, которое проверено при его создании
+            const auto stop_vertex = static_cast<GraphId>(
+                    id_by_stop_name_.at(route->stops.at(static_cast<size_t>(stop_index(position)))->name));
+            const auto on_board_vertex = static_cast<GraphId>(direction_first_vertex + static_cast<size_t>(position));
+            if (position + 1 < stops_count) {
+                edges.push_back({stop_vertex, on_board_vertex,
+                                 {static_cast<double>(settings_.wait_time), bus_id, 0}});
+                edges.push_back({on_board_vertex, on_board_vertex + 1,
+                                 {ComputeRouteTime(route, stop_index(position), stop_index(position + 1)), bus_id, 1}});
+            }
+            if (position > 0) {
+                edges.push_back({on_board_vertex, stop_vertex, {0, bus_id, 0}});
+            }
+        }
+    }
+}
+
+void TransportRouter::CompressChains() {
+    const size_t stop_count = stops_by_id_.size();
+    const size_t vertex_count = graph_.GetVertexCount();
+    const Edges& graph_edges = graph_.GetEdges();
+    const size_t graph_edge_count = graph_edges.size();
+
+    // Ребро рабочего графа: исходное (номер совпадает с номером в графе)
+    // или путь через удалённую вершину из рёбер first и second
+    constexpr size_t NO_EDGE = std::numeric_limits<size_t>::max();
+    struct ChainEdge {
+        size_t from = 0;
+        size_t to = 0;
+        size_t first = NO_EDGE;
+        size_t second = NO_EDGE;
+        bool is_alive = true;
+    };
+    std::vector<ChainEdge> chain_edges;
+    chain_edges.reserve(graph_edge_count);
+    // рёбра вершин "в автобусе", удалённые рёбра отбрасываются при обходе
+    std::vector<std::vector<size_t>> incoming(vertex_count - stop_count);
+    std::vector<std::vector<size_t>> outgoing(vertex_count - stop_count);
+    auto add_edge = [&](ChainEdge edge) {
+        const size_t id = chain_edges.size();
+        if (edge.from >= stop_count) {
+            outgoing[edge.from - stop_count].push_back(id);
+        }
+        if (edge.to >= stop_count) {
+            incoming[edge.to - stop_count].push_back(id);
+        }
+        chain_edges.push_back(edge);
+    };
+    for (const auto& edge : graph_edges) {
+        add_edge({edge.from, edge.to});
+    }
+
+    // вершины удаляются по порядку номеров, то есть вдоль направлений движения
+    std::vector<bool> is_removed(vertex_count, false);
+    std::vector<size_t> in_edges;
+    std::vector<size_t> out_edges;
+    auto collect_alive = [&chain_edges](std::vector<size_t>& edges, std::vector<size_t>& alive) {
+        alive.clear();
+        for (const auto id : edges) {
+            if (chain_edges[id].is_alive) {
+                alive.push_back(id);
+            }
+        }
+        std::vector<size_t>().swap(edges);
+    };
+    for (size_t vertex = stop_count; vertex < vertex_count; ++vertex) {
+        collect_alive(incoming[vertex - stop_count], in_edges);
+        collect_alive(outgoing[vertex - stop_count], out_edges);
+        // петли на остановке (посадка и сразу высадка) в кратчайшие пути не входят
+        size_t path_count = 0;
+        for (const auto in_id : in_edges) {
+            for (const auto out_id : out_edges) {
+                path_count += chain_edges[in_id].from != chain_edges[out_id].to ? 1 : 0;
+            }
+        }
+        if (path_count > in_edges.size() + out_edges.size()) {
+            // вершина остаётся в графе, рёбра возвращаются в списки
+            incoming[vertex - stop_count] = in_edges;
+            outgoing[vertex - stop_count] = out_edges;
+            continue;
+        }
+        for (const auto in_id : in_edges) {
+            for (const auto out_id : out_edges) {
+                if (chain_edges[in_id].from != chain_edges[out_id].to) {
+                    add_edge({chain_edges[in_id].from, chain_edges[out_id].to, in_id, out_id});
                 }
             }
+            chain_edges[in_id].is_alive = false;
+        }
+        for (const auto out_id : out_edges) {
+            chain_edges[out_id].is_alive = false;
+        }
+        is_removed[vertex] = true;
+    }
+
+    // остановки сохраняют номера, оставшиеся вершины "в автобусе" нумеруются подряд за ними
+    std::vector<GraphId> new_ids(vertex_count, 0);
+    size_t new_vertex_count = 0;
+    for (size_t vertex = 0; vertex < vertex_count; ++vertex) {
+        if (!is_removed[vertex]) {
+            new_ids[vertex] = static_cast<GraphId>(new_vertex_count++);
+        }
+    }
+    Graph graph(new_vertex_count);
+    for (size_t id = 0; id < graph_edge_count; ++id) {
+        if (chain_edges[id].is_alive) {
+            const auto& edge = graph_edges[id];
+            graph.AddEdge({new_ids[edge.from], new_ids[edge.to], edge.weight});
+        }
+    }
+
+    // рёбра цепочек идут после исходных, их пути раскрываются в веса исходных рёбер по порядку
+    ChainEdges result;
+    result.first_edge_id = graph.GetEdgeCount();
+    result.offsets.push_back(0);
+    std::vector<size_t> stack;
+    for (size_t id = graph_edge_count; id < chain_edges.size(); ++id) {
+        if (!chain_edges[id].is_alive) {
+            continue;
+        }
+        RouteWeight weight;
+        size_t span_count = 0;
+        stack.push_back(id);
+        while (!stack.empty()) {
+            const size_t edge_id = stack.back();
+            stack.pop_back();
+            if (chain_edges[edge_id].first != NO_EDGE) {
+                stack.push_back(chain_edges[edge_id].second);
+                stack.push_back(chain_edges[edge_id].first);
+                continue;
+            }
+            const auto& step = graph_edges[edge_id].weight;
+            // время складывается в порядке рёбер пути, автобус - первой посадки
+            if (result.weights.size() == result.offsets.back()) {
+                weight.bus_id = step.bus_id;
+            }
+            weight.total_time += step.total_time;
+            span_count += step.span_count;
+            result.weights.push_back(step);
+        }
+        if (span_count > std::numeric_limits<uint16_t>::max()
+                || result.weights.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("Too many spans in compressed chain");
+        }
+        weight.span_count = static_cast<uint16_t>(span_count);
+        result.offsets.push_back(static_cast<uint32_t>(result.weights.size()));
+        const auto& chain_edge = chain_edges[id];
+        graph.AddEdge({new_ids[chain_edge.from], new_ids[chain_edge.to], weight});
+    }
+    graph_ = std::move(graph);
+    chain_edges_ = std::move(result);
+}
+
+size_t TransportRouter::CountOnBoardVertices() const {
+    size_t result = 0;
+    for (const auto& [route_name, route] : catalogue_.GetRoutes()) {
+        result += CountBusOnBoardVertices(route);
+    }
+    return result;
+}
+
+size_t TransportRouter::CountBusOnBoardVertices(const domain::Bus *route) {
+    return route->stops.size() * (route->route_type == domain::RouteType::LINEAR ? 2 : 1);
+}
+
+void TransportRouter::BuildBusEdges(const domain::Bus *route, Edges& edges) const {
+    if (route->stops.size() > std::numeric_limits<uint16_t>::max()) {
+        throw std::length_error("Too many stops in bus "s + route->name + " for 16-bit span count"s);
+    }
+    int stops_count = static_cast<int>(route->stops.size());
+    const size_t pair_count = route->stops.size() * (route->stops.size() - 1) / 2;
+    edges.reserve(route->route_type == domain::RouteType::LINEAR ? 2 * pair_count : pair_count);
+    for(int i = 0; i < stops_count - 1; ++i) {
+        double route_time = settings_.wait_time;
+        double route_time_back = settings_.wait_time;
+        for(int j = i + 1; j < stops_count; ++j) {
+            GraphEdge edge = MakeEdge(route, i, j);
+            route_time += ComputeRouteTime(route, j - 1, j);
+            edge.weight.total_time = route_time;
+            edges.push_back(edge);
+            if (route->route_type == domain::RouteType::LINEAR) {
+                int i_back = stops_count - 1 - i;
+                int j_back = stops_count - 1 - j;
+                GraphEdge edge = MakeEdge(route, i_back, j_back);
+                route_time_back += ComputeRouteTime(route, j_back + 1, j_back);
+                edge.weight.total_time = route_time_back;
+                edges.push_back(edge);
+            }
         }
     }
 }
 
+void TransportRouter::PrepareHeuristic() {
+    coordinates_by_id_.assign(graph_.GetVertexCount(), geo::Coordinates{});
+    for (size_t id = 0; id < stops_by_id_.size(); ++id) {
+        coordinates_by_id_.at(id) = stops_by_id_[id]->coordinate;
+    }
+    // вершина "в автобусе" находится на остановке, с которой в неё садятся или на которую из неё выходят
+    const size_t stop_count = stops_by_id_.size();
+    const Graph& graph = graph_;
+    for (graph::EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+        // ребро цепочки может начинаться на другой остановке пути
+        if (IsChainEdge(edge_id)) {
+            continue;
+        }
+        const auto& edge = graph.GetEdge(edge_id);
+        if (edge.from < stop_count && edge.to >= stop_count) {
+            coordinates_by_id_.at(edge.to) = coordinates_by_id_.at(edge.from);
+        } else if (edge.from >= stop_count && edge.to < stop_count) {
+            coordinates_by_id_.at(edge.from) = coordinates_by_id_.at(edge.to);
+        }
+    }
+
+    // дорожное расстояние между остановками может быть меньше расстояния по прямой,
+    // поэтому оценка масштабируется минимальным отношением по всем перегонам.
+    // Маршрут по рёбрам графа состоит из перегонов, так что по неравенству треугольника
+    // road_distance_factor_ * (расстояние по прямой) не больше дорожного расстояния
+    double factor = std::numeric_limits<double>::infinity();
+    auto update_factor = [&](const domain::Bus* route, size_t from, size_t to) {
+        const domain::Stop* stop_from = route->stops[from];
+        const domain::Stop* stop_to = route->stops[to];
+        const double distance = geo::ComputeDistance(stop_from->coordinate, stop_to->coordinate);
+        if (distance > 0) {
+            // расстояния известны не все: ошибка об отсутствующем перегоне даётся каталогом
+            const int road_distance = route->HasDistances()
+                    ? route->GetDistance(from, to)
+                    : catalogue_.GetDistance(stop_from->name, stop_to->name);
+            factor = std::min(factor, road_distance / distance);
+        }
+    };
+    for (const auto& [route_name, route] : catalogue_.GetRoutes()) {
+        for (size_t i = 1; i < route->stops.size(); ++i) {
+            update_factor(route, i - 1, i);
+            if (route->route_type == domain::RouteType::LINEAR) {
+                update_factor(route, i, i - 1);
+            }
+        }
+    }
+    // запас на погрешность вычисления расстояний
+    constexpr double FACTOR_MARGIN = 1.0 - 1e-9;
+    road_distance_factor_ = std::isfinite(factor) ? factor * FACTOR_MARGIN : 0.0;
+}
+
+RouteWeight TransportRouter::EstimateRouteWeight(graph::VertexId from, graph::VertexId to) const {
+    RouteWeight result;
+    if (from == to) {
+        return result;
+    }
+    // с другой остановки нужна хотя бы одна поездка, а значит и одно ожидание;
+    // в вершине "в автобусе" модели ON_BOARD ожидание уже позади
+    const double distance = geo::ComputeDistance(coordinates_by_id_[from], coordinates_by_id_[to]);
+    if (from < stops_by_id_.size()) {
+        result.total_time = settings_.wait_time;
+    }
+    // для совпадающих координат acos может вернуть NaN
+    if (distance > 0) {
+        result.total_time += road_distance_factor_ * distance / settings_.velocity;
+    }
+    return result;
+}
+
 size_t TransportRouter::CountStops() {
-    size_t stops_counter = 0;
     const auto &stops = catalogue_.GetStops();
-    id_by_stop_name_.reserve(stops.size());
-    stops_by_id_.reserve(stops.size());
-    for (auto stop : stops) {
-        id_by_stop_name_.insert({stop.first, stops_counter});
-        stops_by_id_.insert({stops_counter++, stop.second});
+    if (stops.empty()) {
+        return 0;
     }
-    return stops_counter;
+    geo::Coordinates min = stops.begin()->second->coordinate;
+    geo::Coordinates max = min;
+    for (const auto& [name, stop] : stops) {
+        min = {std::min(min.lat, stop->coordinate.lat), std::min(min.lng, stop->coordinate.lng)};
+        max = {std::max(max.lat, stop->coordinate.lat), std::max(max.lng, stop->coordinate.lng)};
+    }
+
+    // порядок Мортона (Z-кривая) по координатам: соседние остановки получают близкие номера.
+    // При равных ключах порядок задаёт имя, поэтому нумерация не зависит от порядка хэш-таблицы
+    std::vector<std::pair<uint64_t, const domain::Stop*>> keys;
+    keys.reserve(stops.size());
+    for (const auto& [name, stop] : stops) {
+        const uint64_t lat_cell = ComputeCell(stop->coordinate.lat, min.lat, max.lat);
+        const uint64_t lng_cell = ComputeCell(stop->coordinate.lng, min.lng, max.lng);
+        keys.push_back({(SpreadBits(lat_cell) << 1) | SpreadBits(lng_cell), stop});
+    }
+    std::sort(keys.begin(), keys.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first != rhs.first ? lhs.first < rhs.first : lhs.second->name < rhs.second->name;
+    });
+
+    id_by_stop_name_.reserve(keys.size());
+    stops_by_id_.reserve(keys.size());
+    for (const auto& [key, stop] : keys) {
+        id_by_stop_name_.insert({stop->name, stops_by_id_.size()});
+        stops_by_id_.push_back(stop);
+    }
+    return stops_by_id_.size();
+}
+
+void TransportRouter::CountBuses() {
+    const auto &routes = catalogue_.GetRoutes();
+    buses_by_id_.reserve(routes.size());
+    id_by_bus_name_.reserve(routes.size());
+    for (const auto& [route_name, route] : routes) {
+        AddBusId(route);
+    }
+}
+
+uint32_t TransportRouter::AddBusId(const domain::Bus *route) {
+    if (buses_by_id_.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Too many buses for 32-bit bus ids");
+    }
+    const auto id = static_cast<uint32_t>(buses_by_id_.size());
+    buses_by_id_.push_back(route);
+    id_by_bus_name_.insert({route->name, id});
+    return id;
 }
 
-graph::Edge<RouteWeight> TransportRouter::MakeEdge(const domain::Bus *route,
-                                                 int stop_from_index, int stop_to_index) {
+TransportRouter::GraphEdge TransportRouter::MakeEdge(const domain::Bus *route,
+                                                    int stop_from_index, int stop_to_index) const {
 
-    graph::Edge<RouteWeight> edge;
-    edge.from = id_by_stop_name_.at(route->stops.at(static_cast<size_t>(stop_from_index))->name);
-    edge.to = id_by_stop_name_.at(route->stops.at(static_cast<size_t>(stop_to_index))->name);
-    edge.weight.bus_name = route->name;
-    edge.weight.span_count = static_cast<int>(stop_to_index - stop_from_index);
+    // номера остановок меньше числа вершин графа, которое проверено при его создании
+    GraphEdge edge;
+    edge.from = static_cast<GraphId>(id_by_stop_name_.at(route->stops.at(static_cast<size_t>(stop_from_index))->name));
+    edge.to = static_cast<GraphId>(id_by_stop_name_.at(route->stops.at(static_cast<size_t>(stop_to_index))->name));
+    edge.weight.bus_id = id_by_bus_name_.at(route->name);
+    // на обратном пути линейного маршрута stop_to_index < stop_from_index: в ответе печатается
+    // число перегонов, а не отрицательная разность номеров, как до модели ON_BOARD
+    edge.weight.span_count = static_cast<uint16_t>(std::abs(stop_to_index - stop_from_index));
     return edge;
 }
 
-double TransportRouter::ComputeRouteTime(const domain::Bus *route, int stop_from_index, int stop_to_index) {
-    auto split_distance =
-            catalogue_.GetDistance(route->stops.at(static_cast<size_t>(stop_from_index))->name,
-                                    route->stops.at(static_cast<size_t>(stop_to_index))->name);
+double TransportRouter::ComputeRouteTime(const domain::Bus *route, int stop_from_index, int stop_to_index) const {
+    const auto from = static_cast<size_t>(stop_from_index);
+    const auto to = static_cast<size_t>(stop_to_index);
+    if (route->HasDistances()) {
+        return route->GetDistance(from, to) / settings_.velocity;
+    }
+    // расстояния известны не все: ошибка об отсутствующем перегоне даётся каталогом
+    auto split_distance = catalogue_.GetDistance(route->stops.at(from)->name, route->stops.at(to)->name);
     return split_distance / settings_.velocity;
 }
 
+size_t TransportRouter::StopIdsPairHasher::operator()(const StopIdsPair& stop_ids) const {
+    return std::hash<size_t>{}(stop_ids.first) * 37 + std::hash<size_t>{}(stop_ids.second);
+}
+
 bool operator<(const RouteWeight &left, const RouteWeight &right) {
     return left.total_time < right.total_time;
 }
@@ -1,13 +1,25 @@
 #pragma once
 
+#include "contraction_hierarchy.h"
+#include "dijkstra_router.h"
+#include "geo.h"
 #include "graph.h"
+#include "hub_labels.h"
+#include "k_shortest_paths.h"
+#include "lazy_router.h"
+#include "lru_cache.h"
+#include "raptor_router.h"
 #include "router.h"
+#include "thread_pool.h"
 #include "transport_catalogue.h"
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
@@ -17,27 +29,105 @@ namespace transport_router {
 // коэффициент перевода км/ч в м/мин
 constexpr static double KMH_TO_MMIN = 1000.0 / 60.0;
 
+// Вес ребра графа: 16 байт вместо 32 с именем автобуса.
+// Автобус задаётся номером в TransportRouter, имя получается по нему при формировании ответа.
+// Время остаётся double: float или фиксированная точка меняли бы выбор и время маршрутов
 struct RouteWeight {
-    std::string_view bus_name;
     double total_time = 0;
-    int span_count = 0;
+    uint32_t bus_id = 0;
+    // число перегонов ребра, без знака и на обратном пути линейного маршрута
+    uint16_t span_count = 0;
 };
 
 bool operator<(const RouteWeight &left, const RouteWeight &right);
 bool operator>(const RouteWeight &left, const RouteWeight &right);
 RouteWeight operator+(const RouteWeight &left, const RouteWeight &right);
 
+} // namespace transport_router
+
+namespace graph {
+
+// в таблицах маршрутов от веса остаётся только время
+template <>
+struct WeightTraits<transport_router::RouteWeight> {
+    using Value = double;
+
+    static Value ToValue(const transport_router::RouteWeight& weight) {
+        return weight.total_time;
+    }
+    static transport_router::RouteWeight FromValue(Value value) {
+        transport_router::RouteWeight weight;
+        weight.total_time = value;
+        return weight;
+    }
+};
+
+} // namespace graph
+
+namespace transport_router {
+
+// Работа с маршрутизатором делится на две фазы. Построение (InitRouter, AddBus, Rebuild)
+// меняет структуры и выполняется одним потоком. После него константные запросы
+// (BuildRoute, GetRouteTime, BuildIsochrone, BuildTravelTimeMatrix) не меняют маршрутизатор
+// и могут выполняться из нескольких потоков одновременно: рабочие буферы поиска у каждого
+// потока свои. Запрос до построения - исключение std::logic_error
 class TransportRouter {
 public:
 
-    using Graph = graph::DirectedWeightedGraph<RouteWeight>;
-    using StopsById = std::unordered_map<size_t, const domain::Stop*>;
+    // номер вершины или ребра в структурах графа и таблицы маршрутов
+    using GraphId = uint32_t;
+    using Graph = graph::DirectedWeightedGraph<RouteWeight, GraphId>;
+    using GraphEdge = graph::Edge<RouteWeight, GraphId>;
+    // остановка по номеру вершины: номера остановок идут подряд с нуля
+    using StopsById = std::vector<const domain::Stop*>;
     using IdsByStopName = std::unordered_map<std::string_view, size_t>;
-    using Router = graph::Router<RouteWeight>;
+    using BusesById = std::vector<const domain::Bus*>;
+    using IdsByBusName = std::unordered_map<std::string_view, uint32_t>;
+    using Router = graph::Router<RouteWeight, GraphId>;
+    using DijkstraRouter = graph::DijkstraRouter<RouteWeight>;
+    using ContractionHierarchy = graph::ContractionHierarchy<RouteWeight>;
+    using LazyRouter = graph::LazyRouter<RouteWeight>;
+    using KShortestPaths = graph::KShortestPaths<RouteWeight>;
+    using HubLabels = graph::HubLabels<RouteWeight>;
+
+    // Алгоритм поиска маршрута
+    enum class Engine {
+        ALL_PAIRS,  // таблица всех пар вершин (Флойд-Уоршелл) при построении
+        DIJKSTRA,   // поиск Дейкстры на каждый запрос
+        CONTRACTION_HIERARCHY,  // иерархия сжатия при построении, двунаправленный поиск на запрос
+        A_STAR,     // поиск A* на каждый запрос с оценкой по расстоянию по прямой
+        RAPTOR,     // поиск по раундам по маршрутам автобусов, граф не строится
+        LAZY_ROWS,  // строки таблицы маршрутов вычисляются при первом запросе из вершины
+    };
+
+    // Модель графа для алгоритмов, работающих по графу
+    enum class GraphModel {
+        STOP_PAIRS, // ребро на каждую пару остановок маршрута: O(k^2) рёбер на автобус
+        ON_BOARD,   // вершины "в автобусе" на каждой позиции маршрута: O(k) рёбер на автобус
+    };
 
     struct RoutingSettings {
         int wait_time = 0;      // мин
         double velocity = 100;  // м/с
+        Engine engine = Engine::ALL_PAIRS;
+        size_t route_cache_size = 0;    // число запоминаемых ответов, 0 - без кэша
+        size_t lazy_row_limit = 256;    // число хранимых строк для LAZY_ROWS
+        GraphModel graph_model = GraphModel::STOP_PAIRS;
+        // метки опорных вершин для времени в пути без поиска (кроме RAPTOR)
+        bool hub_labels = false;
+        // построение таблицы всех пар для ALL_PAIRS
+        Router::Algorithm all_pairs_algorithm = Router::Algorithm::BLOCKED;
+        // сжатие цепочек вершин "в автобусе" модели ON_BOARD перед построением алгоритма
+        bool compress_chains = false;
+    };
+
+    // Рёбра сжатых цепочек идут в графе подряд начиная с first_edge_id и заменяют пути
+    // через удалённые вершины "в автобусе". Ребро first_edge_id + i раскрывается в веса
+    // исходных рёбер пути weights[offsets[i]], ..., weights[offsets[i + 1] - 1]
+    struct ChainEdges {
+        graph::EdgeId first_edge_id = 0;
+        std::vector<uint32_t> offsets;
+        std::vector<RouteWeight> weights;
     };
 
     struct RouterEdge {
@@ -49,18 +139,91 @@ public:
     };
     using TransportRoute = std::vector<RouterEdge>;
 
+    using StopIdsPair = std::pair<graph::VertexId, graph::VertexId>;
+    struct StopIdsPairHasher {
+        size_t operator()(const StopIdsPair& stop_ids) const;
+    };
+    // готовые ответы по паре (откуда, куда), включая отсутствие маршрута
+    using RouteCache = cache::LruCache<StopIdsPair, std::optional<TransportRoute>, StopIdsPairHasher>;
+
+    // рабочие буферы запросов одного потока
+    struct QueryScratch {
+        // рёбра последнего маршрута
+        std::vector<graph::EdgeId> route_edges;
+        DijkstraRouter::Scratch dijkstra;
+        ContractionHierarchy::Scratch hierarchy;
+        RaptorRouter::Scratch raptor;
+        std::vector<double> arrivals;
+        KShortestPaths::Scratch k_shortest_paths;
+        // поиск времени в пути до нескольких остановок
+        graph::TargetWeightsScratch<RouteWeight> target_search;
+        std::vector<std::optional<RouteWeight>> target_weights;
+    };
+
     TransportRouter(const transport_catalogue::TransportCatalogue &catalogue,
                     const RoutingSettings &settings);
 
-    std::optional<TransportRoute> BuildRoute(const std::string &from, const std::string &to);
+    // маршрут с буферами текущего потока
+    std::optional<TransportRoute> BuildRoute(const std::string &from, const std::string &to) const;
+    // маршрут с буферами вызывающего
+    std::optional<TransportRoute> BuildRoute(const std::string &from, const std::string &to,
+                                             QueryScratch& scratch) const;
+
+    // До max_route_count маршрутов по возрастанию времени, различающихся последовательностью автобусов.
+    // Строятся алгоритмом Йена по графу; для RAPTOR графа нет, и возвращается только лучший маршрут.
+    // Маршруты с буферами текущего потока
+    std::vector<TransportRoute> BuildRoutes(const std::string &from, const std::string &to,
+                                            size_t max_route_count) const;
+    // маршруты с буферами вызывающего
+    std::vector<TransportRoute> BuildRoutes(const std::string &from, const std::string &to,
+                                            size_t max_route_count, QueryScratch& scratch) const;
+
+    // Время в пути от from до to, nullopt - маршрута нет.
+    // С метками опорных вершин вычисляется слиянием двух меток, иначе - построением маршрута
+    std::optional<double> GetRouteTime(const std::string &from, const std::string &to) const;
+
+    // остановка и время в пути до неё
+    struct StopTime {
+        std::string_view stop_name;
+        double time = 0;
+    };
+    using Isochrone = std::vector<StopTime>;
+
+    // все остановки, достижимые из from не более чем за max_time минут, по возрастанию времени
+    Isochrone BuildIsochrone(const std::string& from, double max_time) const;
+
+    // время в пути до каждой из остановок назначения, nullopt - маршрута нет
+    using TravelTimes = std::vector<std::optional<double>>;
+    using TravelTimesHandler = std::function<void(size_t origin_index, const TravelTimes& times)>;
+
+    // Матрица времени в пути от origins до destinations: по одному поиску на остановку отправления
+    // (для таблицы всех пар - чтение её строк). Строки считаются параллельно пачками и
+    // передаются в handler по порядку origins, поэтому вся матрица в памяти не хранится.
+    // Неизвестная остановка - исключение std::out_of_range до передачи первой строки
+    void BuildTravelTimeMatrix(const std::vector<std::string>& origins,
+                               const std::vector<std::string>& destinations,
+                               const TravelTimesHandler& handler) const;
 
     const RoutingSettings& GetSettings() const;
     RoutingSettings& GetSettings();
 
+    // фаза построения: граф и структуры выбранного алгоритма
     void InitRouter();
 
     void InternalInit();
 
+    bool IsInitialized() const;
+
+    // Учитывает автобус, добавленный в каталог после построения маршрутизатора:
+    // в граф добавляются только его рёбра, таблица всех пар дополняется через них
+    // (остальные алгоритмы перестраивают свои структуры по дополненному графу).
+    // Если автобус проходит через новые остановки или граф построен в модели ON_BOARD
+    // (автобус добавляет вершины), маршрутизатор перестраивается целиком
+    void AddBus(std::string_view bus_name);
+
+    // Полная перестройка после изменения или удаления автобусов и расстояний
+    void Rebuild();
+
 
     Graph& GetGraph();
     const Graph& GetGraph() const;
@@ -68,12 +231,41 @@ public:
     std::unique_ptr<Router>& GetRouter();
     const std::unique_ptr<Router>& GetRouter() const;
 
+    std::unique_ptr<DijkstraRouter>& GetDijkstraRouter();
+    const std::unique_ptr<DijkstraRouter>& GetDijkstraRouter() const;
+
+    std::unique_ptr<ContractionHierarchy>& GetContractionHierarchy();
+    const std::unique_ptr<ContractionHierarchy>& GetContractionHierarchy() const;
+
+    std::unique_ptr<RaptorRouter>& GetRaptorRouter();
+    const std::unique_ptr<RaptorRouter>& GetRaptorRouter() const;
+
+    std::unique_ptr<LazyRouter>& GetLazyRouter();
+    const std::unique_ptr<LazyRouter>& GetLazyRouter() const;
+
+    std::unique_ptr<HubLabels>& GetHubLabels();
+    const std::unique_ptr<HubLabels>& GetHubLabels() const;
+
+    // пустая таблица, если граф не сжимался
+    ChainEdges& GetChainEdges();
+    const ChainEdges& GetChainEdges() const;
+
+    // кэш ответов, nullptr если отключён в настройках
+    const RouteCache* GetRouteCache() const;
+
     StopsById& GetStopsById();
     const StopsById& GetStopsById() const;
 
     IdsByStopName& GetIdsByStopName();
     const IdsByStopName& GetIdsByStopName() const;
 
+    // номера автобусов в весах рёбер
+    BusesById& GetBusesById();
+    const BusesById& GetBusesById() const;
+
+    IdsByBusName& GetIdsByBusName();
+    const IdsByBusName& GetIdsByBusName() const;
+
 private:
 
     bool is_initialized_ = false;
@@ -83,14 +275,80 @@ private:
 
     StopsById stops_by_id_;
     IdsByStopName id_by_stop_name_;
+    BusesById buses_by_id_;
+    IdsByBusName id_by_bus_name_;
 
     Graph graph_;
-    mutable std::unique_ptr<Router> router_;
+    std::unique_ptr<Router> router_;
+    std::unique_ptr<DijkstraRouter> dijkstra_router_;
+    std::unique_ptr<ContractionHierarchy> contraction_hierarchy_;
+    std::unique_ptr<RaptorRouter> raptor_router_;
+    std::unique_ptr<LazyRouter> lazy_router_;
+    std::unique_ptr<HubLabels> hub_labels_;
+    ChainEdges chain_edges_;
+    // строится вместе с графом, для RAPTOR не создаётся
+    std::unique_ptr<KShortestPaths> k_shortest_paths_;
+    // кэш сам защищён мьютексом, поэтому доступен константным запросам
+    std::unique_ptr<RouteCache> route_cache_;
+    // потоки построения рёбер и матриц времени, создаются вместе с маршрутизатором.
+    // Пачки матриц и рёбра при перестройке идут подряд сериями разного размера: пул не пускает
+    // в серию потоки, проснувшиеся после разбора её задач, поэтому каждый слот результата
+    // заполняет один поток. Серии одновременных матриц пул выполняет по очереди
+    std::unique_ptr<concurrency::ThreadPool> thread_pool_;
+
+    // данные оценки для A*: координаты вершин и отношение дорожного расстояния
+    // к расстоянию по прямой, не превосходящее его ни на одном перегоне
+    std::vector<geo::Coordinates> coordinates_by_id_;
+    double road_distance_factor_ = 0;
+
+    void PrepareHeuristic();
+    // нижняя оценка веса маршрута от from до to
+    RouteWeight EstimateRouteWeight(graph::VertexId from, graph::VertexId to) const;
+
+    // бросает std::logic_error, если фаза построения не пройдена
+    void CheckInitialized() const;
+    // буферы запросов текущего потока
+    static QueryScratch& GetThreadScratch();
+
+    // ищет маршрут между вершинами графа выбранным в настройках алгоритмом, рёбра - в scratch.route_edges
+    std::optional<RouteWeight> FindRoute(graph::VertexId from, graph::VertexId to, QueryScratch& scratch) const;
+    std::optional<TransportRoute> BuildRaptorRoute(graph::VertexId from, graph::VertexId to,
+                                                   QueryScratch& scratch) const;
+    std::optional<TransportRoute> BuildGraphRoute(graph::VertexId from, graph::VertexId to,
+                                                  QueryScratch& scratch) const;
+    TransportRoute MakeTransportRoute(const std::vector<graph::EdgeId>& edges) const;
+    // строка матрицы времени в пути, безопасна для одновременных вызовов с разными scratch
+    void ComputeTravelTimes(graph::VertexId from, const std::vector<graph::VertexId>& destinations,
+                            TravelTimes& times, QueryScratch& scratch) const;
+
+    using Edges = std::vector<GraphEdge>;
 
+    // Рёбра автобусов строятся параллельно в отдельные буферы и добавляются в граф
+    // в порядке автобусов каталога, поэтому номера рёбер не зависят от числа потоков
     void BuildEdges();
+    // рёбра автобуса в модели STOP_PAIRS, безопасно для одновременных вызовов
+    void BuildBusEdges(const domain::Bus *route, Edges& edges) const;
+    // Рёбра автобуса в модели ON_BOARD. Для каждого направления движения заводятся вершины
+    // "в автобусе" на каждой позиции маршрута, начиная с first_vertex: посадка с остановки
+    // (ожидание, 0 перегонов), перегон до следующей позиции (1 перегон) и высадка (0 минут)
+    void BuildBusOnBoardEdges(const domain::Bus *route, graph::VertexId first_vertex, Edges& edges) const;
+    // Удаляет из графа вершины "в автобусе", у которых число путей через вершину (без петель)
+    // не больше числа её рёбер: каждый такой путь становится ребром цепочки, поэтому рёбер
+    // не становится больше, а кратчайшие пути не меняются. Остановки сохраняют номера
+    void CompressChains();
+    bool IsChainEdge(graph::EdgeId edge_id) const;
+    size_t CountOnBoardVertices() const;
+    static size_t CountBusOnBoardVertices(const domain::Bus *route);
+    // сбрасывает кэш готовых ответов
+    void ResetRouteCaches();
+    // нумерует остановки в порядке расположения на карте, чтобы вершины, соседние в графе,
+    // были близки и в памяти
     size_t CountStops();
-    graph::Edge<RouteWeight> MakeEdge(const domain::Bus *route, int stop_from_index, int stop_to_index);
-    double ComputeRouteTime(const domain::Bus *route, int stop_from_index, int stop_to_index);
+    void CountBuses();
+    // присваивает автобусу следующий номер
+    uint32_t AddBusId(const domain::Bus *route);
+    GraphEdge MakeEdge(const domain::Bus *route, int stop_from_index, int stop_to_index) const;
+    double ComputeRouteTime(const domain::Bus *route, int stop_from_index, int stop_to_index) const;
 };
 
 } // namespace transport_router
@@ -29,6 +29,7 @@
 #include <google/protobuf/message.h>
 #include <google/protobuf/repeated_field.h>  // IWYU pragma: export
 #include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/generated_enum_reflection.h>
 #include <google/protobuf/unknown_field_set.h>
 #include "graph.pb.h"
 // @@protoc_insertion_point(includes)
@@ -46,6 +47,9 @@ struct TableStruct_transport_5frouter_2eproto {
 };
 extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_transport_5frouter_2eproto;
 namespace transport_router_serialize {
+class ChainEdges;
+struct ChainEdgesDefaultTypeInternal;
+extern ChainEdgesDefaultTypeInternal _ChainEdges_default_instance_;
 class RouteSettings;
 struct RouteSettingsDefaultTypeInternal;
 extern RouteSettingsDefaultTypeInternal _RouteSettings_default_instance_;
@@ -57,12 +61,92 @@ struct TransportRouterDefaultTypeInternal;
 extern TransportRouterDefaultTypeInternal _TransportRouter_default_instance_;
 }  // namespace transport_router_serialize
 PROTOBUF_NAMESPACE_OPEN
+template<> ::transport_router_serialize::ChainEdges* Arena::CreateMaybeMessage<::transport_router_serialize::ChainEdges>(Arena*);
 template<> ::transport_router_serialize::RouteSettings* Arena::CreateMaybeMessage<::transport_router_serialize::RouteSettings>(Arena*);
 template<> ::transport_router_serialize::StopById* Arena::CreateMaybeMessage<::transport_router_serialize::StopById>(Arena*);
 template<> ::transport_router_serialize::TransportRouter* Arena::CreateMaybeMessage<::transport_router_serialize::TransportRouter>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 namespace transport_router_serialize {
 
+enum RoutingEngine : int {
+  ALL_PAIRS = 0,
+  DIJKSTRA = 1,
+  CONTRACTION_HIERARCHY = 2,
+  A_STAR = 3,
+  RAPTOR = 4,
+  LAZY_ROWS = 5,
+  RoutingEngine_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
+  RoutingEngine_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
+};
+bool RoutingEngine_IsValid(int value);
+constexpr RoutingEngine RoutingEngine_MIN = ALL_PAIRS;
+constexpr RoutingEngine RoutingEngine_MAX = LAZY_ROWS;
+constexpr int RoutingEngine_ARRAYSIZE = RoutingEngine_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* RoutingEngine_descriptor();
+template<typename T>
+inline const std::string& RoutingEngine_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, RoutingEngine>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function RoutingEngine_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    RoutingEngine_descriptor(), enum_t_value);
+}
+inline bool RoutingEngine_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, RoutingEngine* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<RoutingEngine>(
+    RoutingEngine_descriptor(), name, value);
+}
+enum GraphModel : int {
+  STOP_PAIRS = 0,
+  ON_BOARD = 1,
+  GraphModel_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
+  GraphModel_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
+};
+bool GraphModel_IsValid(int value);
+constexpr GraphModel GraphModel_MIN = STOP_PAIRS;
+constexpr GraphModel GraphModel_MAX = ON_BOARD;
+constexpr int GraphModel_ARRAYSIZE = GraphModel_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* GraphModel_descriptor();
+template<typename T>
+inline const std::string& GraphModel_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, GraphModel>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function GraphModel_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    GraphModel_descriptor(), enum_t_value);
+}
+inline bool GraphModel_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, GraphModel* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<GraphModel>(
+    GraphModel_descriptor(), name, value);
+}
+enum AllPairsAlgorithm : int {
+  FLOYD_WARSHALL = 0,
+  PER_SOURCE_DIJKSTRA = 1,
+  AllPairsAlgorithm_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
+  AllPairsAlgorithm_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
+};
+bool AllPairsAlgorithm_IsValid(int value);
+constexpr AllPairsAlgorithm AllPairsAlgorithm_MIN = FLOYD_WARSHALL;
+constexpr AllPairsAlgorithm AllPairsAlgorithm_MAX = PER_SOURCE_DIJKSTRA;
+constexpr int AllPairsAlgorithm_ARRAYSIZE = AllPairsAlgorithm_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* AllPairsAlgorithm_descriptor();
+template<typename T>
+inline const std::string& AllPairsAlgorithm_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, AllPairsAlgorithm>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function AllPairsAlgorithm_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    AllPairsAlgorithm_descriptor(), enum_t_value);
+}
+inline bool AllPairsAlgorithm_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, AllPairsAlgorithm* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<AllPairsAlgorithm>(
+    AllPairsAlgorithm_descriptor(), name, value);
+}
 // ===================================================================
 
 class RouteSettings final :
@@ -188,6 +272,13 @@ class RouteSettings final :
   enum : int {
     kVelocityFieldNumber = 2,
     kWaitTimeFieldNumber = 1,
+    kEngineFieldNumber = 3,
+    kRouteCacheSizeFieldNumber = 4,
+    kLazyRowLimitFieldNumber = 5,
+    kGraphModelFieldNumber = 6,
+    kAllPairsAlgorithmFieldNumber = 8,
+    kHubLabelsFieldNumber = 7,
+    kCompressChainsFieldNumber = 9,
   };
   // double velocity = 2;
   void clear_velocity();
@@ -207,6 +298,69 @@ class RouteSettings final :
   void _internal_set_wait_time(int32_t value);
   public:
 
+  // .transport_router_serialize.RoutingEngine engine = 3;
+  void clear_engine();
+  ::transport_router_serialize::RoutingEngine engine() const;
+  void set_engine(::transport_router_serialize::RoutingEngine value);
+  private:
+  ::transport_router_serialize::RoutingEngine _internal_engine() const;
+  void _internal_set_engine(::transport_router_serialize::RoutingEngine value);
+  public:
+
+  // uint32 route_cache_size = 4;
+  void clear_route_cache_size();
+  uint32_t route_cache_size() const;
+  void set_route_cache_size(uint32_t value);
+  private:
+  uint32_t _internal_route_cache_size() const;
+  void _internal_set_route_cache_size(uint32_t value);
+  public:
+
+  // uint32 lazy_row_limit = 5;
+  void clear_lazy_row_limit();
+  uint32_t lazy_row_limit() const;
+  void set_lazy_row_limit(uint32_t value);
+  private:
+  uint32_t _internal_lazy_row_limit() const;
+  void _internal_set_lazy_row_limit(uint32_t value);
+  public:
+
+  // .transport_router_serialize.GraphModel graph_model = 6;
+  void clear_graph_model();
+  ::transport_router_serialize::GraphModel graph_model() const;
+  void set_graph_model(::transport_router_serialize::GraphModel value);
+  private:
+  ::transport_router_serialize::GraphModel _internal_graph_model() const;
+  void _internal_set_graph_model(::transport_router_serialize::GraphModel value);
+  public:
+
+  // .transport_router_serialize.AllPairsAlgorithm all_pairs_algorithm = 8;
+  void clear_all_pairs_algorithm();
+  ::transport_router_serialize::AllPairsAlgorithm all_pairs_algorithm() const;
+  void set_all_pairs_algorithm(::transport_router_serialize::AllPairsAlgorithm value);
+  private:
+  ::transport_router_serialize::AllPairsAlgorithm _internal_all_pairs_algorithm() const;
+  void _internal_set_all_pairs_algorithm(::transport_router_serialize::AllPairsAlgorithm value);
+  public:
+
+  // bool hub_labels = 7;
+  void clear_hub_labels();
+  bool hub_labels() const;
+  void set_hub_labels(bool value);
+  private:
+  bool _internal_hub_labels() const;
+  void _internal_set_hub_labels(bool value);
+  public:
+
+  // bool compress_chains = 9;
+  void clear_compress_chains();
+  bool compress_chains() const;
+  void set_compress_chains(bool value);
+  private:
+  bool _internal_compress_chains() const;
+  void _internal_set_compress_chains(bool value);
+  public:
+
   // @@protoc_insertion_point(class_scope:transport_router_serialize.RouteSettings)
  private:
   class _Internal;
@@ -217,6 +371,13 @@ class RouteSettings final :
   struct Impl_ {
     double velocity_;
     int32_t wait_time_;
+    int engine_;
+    uint32_t route_cache_size_;
+    uint32_t lazy_row_limit_;
+    int graph_model_;
+    int all_pairs_algorithm_;
+    bool hub_labels_;
+    bool compress_chains_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -383,6 +544,199 @@ class StopById final :
 };
 // -------------------------------------------------------------------
 
+class ChainEdges final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:transport_router_serialize.ChainEdges) */ {
+ public:
+  inline ChainEdges() : ChainEdges(nullptr) {}
+  ~ChainEdges() override;
+  explicit PROTOBUF_CONSTEXPR ChainEdges(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  ChainEdges(const ChainEdges& from);
+  ChainEdges(ChainEdges&& from) noexcept
+    : ChainEdges() {
+    *this = ::std::move(from);
+  }
+
+  inline ChainEdges& operator=(const ChainEdges& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ChainEdges& operator=(ChainEdges&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ChainEdges& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ChainEdges* internal_default_instance() {
+    return reinterpret_cast<const ChainEdges*>(
+               &_ChainEdges_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  friend void swap(ChainEdges& a, ChainEdges& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ChainEdges* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ChainEdges* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ChainEdges* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<ChainEdges>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const ChainEdges& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ChainEdges& from) {
+    ChainEdges::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ChainEdges* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "transport_router_serialize.ChainEdges";
+  }
+  protected:
+  explicit ChainEdges(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kOffsetsFieldNumber = 2,
+    kWeightsFieldNumber = 3,
+    kFirstEdgeIdFieldNumber = 1,
+  };
+  // repeated uint32 offsets = 2;
+  int offsets_size() const;
+  private:
+  int _internal_offsets_size() const;
+  public:
+  void clear_offsets();
+  private:
+  uint32_t _internal_offsets(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      _internal_offsets() const;
+  void _internal_add_offsets(uint32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      _internal_mutable_offsets();
+  public:
+  uint32_t offsets(int index) const;
+  void set_offsets(int index, uint32_t value);
+  void add_offsets(uint32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      offsets() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      mutable_offsets();
+
+  // repeated .graph_serialize.RouteWeight weights = 3;
+  int weights_size() const;
+  private:
+  int _internal_weights_size() const;
+  public:
+  void clear_weights();
+  ::graph_serialize::RouteWeight* mutable_weights(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::RouteWeight >*
+      mutable_weights();
+  private:
+  const ::graph_serialize::RouteWeight& _internal_weights(int index) const;
+  ::graph_serialize::RouteWeight* _internal_add_weights();
+  public:
+  const ::graph_serialize::RouteWeight& weights(int index) const;
+  ::graph_serialize::RouteWeight* add_weights();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::RouteWeight >&
+      weights() const;
+
+  // uint32 first_edge_id = 1;
+  void clear_first_edge_id();
+  uint32_t first_edge_id() const;
+  void set_first_edge_id(uint32_t value);
+  private:
+  uint32_t _internal_first_edge_id() const;
+  void _internal_set_first_edge_id(uint32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:transport_router_serialize.ChainEdges)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t > offsets_;
+    mutable std::atomic<int> _offsets_cached_byte_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::RouteWeight > weights_;
+    uint32_t first_edge_id_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_transport_5frouter_2eproto;
+};
+// -------------------------------------------------------------------
+
 class TransportRouter final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:transport_router_serialize.TransportRouter) */ {
  public:
@@ -431,7 +785,7 @@ class TransportRouter final :
                &_TransportRouter_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    2;
+    3;
 
   friend void swap(TransportRouter& a, TransportRouter& b) {
     a.Swap(&b);
@@ -508,6 +862,9 @@ class TransportRouter final :
     kSettingsFieldNumber = 1,
     kGraphFieldNumber = 3,
     kRouterFieldNumber = 4,
+    kContractionHierarchyFieldNumber = 5,
+    kHubLabelsFieldNumber = 6,
+    kChainEdgesFieldNumber = 7,
   };
   // repeated .transport_router_serialize.StopById stop_by_id = 2;
   int stop_by_id_size() const;
@@ -581,6 +938,60 @@ class TransportRouter final :
       ::graph_serialize::Router* router);
   ::graph_serialize::Router* unsafe_arena_release_router();
 
+  // .graph_serialize.ContractionHierarchy contraction_hierarchy = 5;
+  bool has_contraction_hierarchy() const;
+  private:
+  bool _internal_has_contraction_hierarchy() const;
+  public:
+  void clear_contraction_hierarchy();
+  const ::graph_serialize::ContractionHierarchy& contraction_hierarchy() const;
+  PROTOBUF_NODISCARD ::graph_serialize::ContractionHierarchy* release_contraction_hierarchy();
+  ::graph_serialize::ContractionHierarchy* mutable_contraction_hierarchy();
+  void set_allocated_contraction_hierarchy(::graph_serialize::ContractionHierarchy* contraction_hierarchy);
+  private:
+  const ::graph_serialize::ContractionHierarchy& _internal_contraction_hierarchy() const;
+  ::graph_serialize::ContractionHierarchy* _internal_mutable_contraction_hierarchy();
+  public:
+  void unsafe_arena_set_allocated_contraction_hierarchy(
+      ::graph_serialize::ContractionHierarchy* contraction_hierarchy);
+  ::graph_serialize::ContractionHierarchy* unsafe_arena_release_contraction_hierarchy();
+
+  // .graph_serialize.HubLabels hub_labels = 6;
+  bool has_hub_labels() const;
+  private:
+  bool _internal_has_hub_labels() const;
+  public:
+  void clear_hub_labels();
+  const ::graph_serialize::HubLabels& hub_labels() const;
+  PROTOBUF_NODISCARD ::graph_serialize::HubLabels* release_hub_labels();
+  ::graph_serialize::HubLabels* mutable_hub_labels();
+  void set_allocated_hub_labels(::graph_serialize::HubLabels* hub_labels);
+  private:
+  const ::graph_serialize::HubLabels& _internal_hub_labels() const;
+  ::graph_serialize::HubLabels* _internal_mutable_hub_labels();
+  public:
+  void unsafe_arena_set_allocated_hub_labels(
+      ::graph_serialize::HubLabels* hub_labels);
+  ::graph_serialize::HubLabels* unsafe_arena_release_hub_labels();
+
+  // .transport_router_serialize.ChainEdges chain_edges = 7;
+  bool has_chain_edges() const;
+  private:
+  bool _internal_has_chain_edges() const;
+  public:
+  void clear_chain_edges();
+  const ::transport_router_serialize::ChainEdges& chain_edges() const;
+  PROTOBUF_NODISCARD ::transport_router_serialize::ChainEdges* release_chain_edges();
+  ::transport_router_serialize::ChainEdges* mutable_chain_edges();
+  void set_allocated_chain_edges(::transport_router_serialize::ChainEdges* chain_edges);
+  private:
+  const ::transport_router_serialize::ChainEdges& _internal_chain_edges() const;
+  ::transport_router_serialize::ChainEdges* _internal_mutable_chain_edges();
+  public:
+  void unsafe_arena_set_allocated_chain_edges(
+      ::transport_router_serialize::ChainEdges* chain_edges);
+  ::transport_router_serialize::ChainEdges* unsafe_arena_release_chain_edges();
+
   // @@protoc_insertion_point(class_scope:transport_router_serialize.TransportRouter)
  private:
   class _Internal;
@@ -593,6 +1004,9 @@ class TransportRouter final :
     ::transport_router_serialize::RouteSettings* settings_;
     ::graph_serialize::Graph* graph_;
     ::graph_serialize::Router* router_;
+    ::graph_serialize::ContractionHierarchy* contraction_hierarchy_;
+    ::graph_serialize::HubLabels* hub_labels_;
+    ::transport_router_serialize::ChainEdges* chain_edges_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -649,6 +1063,146 @@ inline void RouteSettings::set_velocity(double value) {
   // @@protoc_insertion_point(field_set:transport_router_serialize.RouteSettings.velocity)
 }
 
+// .transport_router_serialize.RoutingEngine engine = 3;
+inline void RouteSettings::clear_engine() {
+  _impl_.engine_ = 0;
+}
+inline ::transport_router_serialize::RoutingEngine RouteSettings::_internal_engine() const {
+  return static_cast< ::transport_router_serialize::RoutingEngine >(_impl_.engine_);
+}
+inline ::transport_router_serialize::RoutingEngine RouteSettings::engine() const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.RouteSettings.engine)
+  return _internal_engine();
+}
+inline void RouteSettings::_internal_set_engine(::transport_router_serialize::RoutingEngine value) {
+  
+  _impl_.engine_ = value;
+}
+inline void RouteSettings::set_engine(::transport_router_serialize::RoutingEngine value) {
+  _internal_set_engine(value);
+  // @@protoc_insertion_point(field_set:transport_router_serialize.RouteSettings.engine)
+}
+
+// uint32 route_cache_size = 4;
+inline void RouteSettings::clear_route_cache_size() {
+  _impl_.route_cache_size_ = 0u;
+}
+inline uint32_t RouteSettings::_internal_route_cache_size() const {
+  return _impl_.route_cache_size_;
+}
+inline uint32_t RouteSettings::route_cache_size() const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.RouteSettings.route_cache_size)
+  return _internal_route_cache_size();
+}
+inline void RouteSettings::_internal_set_route_cache_size(uint32_t value) {
+  
+  _impl_.route_cache_size_ = value;
+}
+inline void RouteSettings::set_route_cache_size(uint32_t value) {
+  _internal_set_route_cache_size(value);
+  // @@protoc_insertion_point(field_set:transport_router_serialize.RouteSettings.route_cache_size)
+}
+
+// uint32 lazy_row_limit = 5;
+inline void RouteSettings::clear_lazy_row_limit() {
+  _impl_.lazy_row_limit_ = 0u;
+}
+inline uint32_t RouteSettings::_internal_lazy_row_limit() const {
+  return _impl_.lazy_row_limit_;
+}
+inline uint32_t RouteSettings::lazy_row_limit() const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.RouteSettings.lazy_row_limit)
+  return _internal_lazy_row_limit();
+}
+inline void RouteSettings::_internal_set_lazy_row_limit(uint32_t value) {
+  
+  _impl_.lazy_row_limit_ = value;
+}
+inline void RouteSettings::set_lazy_row_limit(uint32_t value) {
+  _internal_set_lazy_row_limit(value);
+  // @@protoc_insertion_point(field_set:transport_router_serialize.RouteSettings.lazy_row_limit)
+}
+
+// .transport_router_serialize.GraphModel graph_model = 6;
+inline void RouteSettings::clear_graph_model() {
+  _impl_.graph_model_ = 0;
+}
+inline ::transport_router_serialize::GraphModel RouteSettings::_internal_graph_model() const {
+  return static_cast< ::transport_router_serialize::GraphModel >(_impl_.graph_model_);
+}
+inline ::transport_router_serialize::GraphModel RouteSettings::graph_model() const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.RouteSettings.graph_model)
+  return _internal_graph_model();
+}
+inline void RouteSettings::_internal_set_graph_model(::transport_router_serialize::GraphModel value) {
+  
+  _impl_.graph_model_ = value;
+}
+inline void RouteSettings::set_graph_model(::transport_router_serialize::GraphModel value) {
+  _internal_set_graph_model(value);
+  // @@protoc_insertion_point(field_set:transport_router_serialize.RouteSettings.graph_model)
+}
+
+// bool hub_labels = 7;
+inline void RouteSettings::clear_hub_labels() {
+  _impl_.hub_labels_ = false;
+}
+inline bool RouteSettings::_internal_hub_labels() const {
+  return _impl_.hub_labels_;
+}
+inline bool RouteSettings::hub_labels() const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.RouteSettings.hub_labels)
+  return _internal_hub_labels();
+}
+inline void RouteSettings::_internal_set_hub_labels(bool value) {
+  
+  _impl_.hub_labels_ = value;
+}
+inline void RouteSettings::set_hub_labels(bool value) {
+  _internal_set_hub_labels(value);
+  // @@protoc_insertion_point(field_set:transport_router_serialize.RouteSettings.hub_labels)
+}
+
+// .transport_router_serialize.AllPairsAlgorithm all_pairs_algorithm = 8;
+inline void RouteSettings::clear_all_pairs_algorithm() {
+  _impl_.all_pairs_algorithm_ = 0;
+}
+inline ::transport_router_serialize::AllPairsAlgorithm RouteSettings::_internal_all_pairs_algorithm() const {
+  return static_cast< ::transport_router_serialize::AllPairsAlgorithm >(_impl_.all_pairs_algorithm_);
+}
+inline ::transport_router_serialize::AllPairsAlgorithm RouteSettings::all_pairs_algorithm() const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.RouteSettings.all_pairs_algorithm)
+  return _internal_all_pairs_algorithm();
+}
+inline void RouteSettings::_internal_set_all_pairs_algorithm(::transport_router_serialize::AllPairsAlgorithm value) {
+  
+  _impl_.all_pairs_algorithm_ = value;
+}
+inline void RouteSettings::set_all_pairs_algorithm(::transport_router_serialize::AllPairsAlgorithm value) {
+  _internal_set_all_pairs_algorithm(value);
+  // @@protoc_insertion_point(field_set:transport_router_serialize.RouteSettings.all_pairs_algorithm)
+}
+
+// bool compress_chains = 9;
+inline void RouteSettings::clear_compress_chains() {
+  _impl_.compress_chains_ = false;
+}
+inline bool RouteSettings::_internal_compress_chains() const {
+  return _impl_.compress_chains_;
+}
+inline bool RouteSettings::compress_chains() const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.RouteSettings.compress_chains)
+  return _internal_compress_chains();
+}
+inline void RouteSettings::_internal_set_compress_chains(bool value) {
+  
+  _impl_.compress_chains_ = value;
+}
+inline void RouteSettings::set_compress_chains(bool value) {
+  _internal_set_compress_chains(value);
+  // @@protoc_insertion_point(field_set:transport_router_serialize.RouteSettings.compress_chains)
+}
+
 // -------------------------------------------------------------------
 
 // StopById
@@ -695,6 +1249,114 @@ inline void StopById::set_stop_id(uint32_t value) {
 
 // -------------------------------------------------------------------
 
+// ChainEdges
+
+// uint32 first_edge_id = 1;
+inline void ChainEdges::clear_first_edge_id() {
+  _impl_.first_edge_id_ = 0u;
+}
+inline uint32_t ChainEdges::_internal_first_edge_id() const {
+  return _impl_.first_edge_id_;
+}
+inline uint32_t ChainEdges::first_edge_id() const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.ChainEdges.first_edge_id)
+  return _internal_first_edge_id();
+}
+inline void ChainEdges::_internal_set_first_edge_id(uint32_t value) {
+  
+  _impl_.first_edge_id_ = value;
+}
+inline void ChainEdges::set_first_edge_id(uint32_t value) {
+  _internal_set_first_edge_id(value);
+  // @@protoc_insertion_point(field_set:transport_router_serialize.ChainEdges.first_edge_id)
+}
+
+// repeated uint32 offsets = 2;
+inline int ChainEdges::_internal_offsets_size() const {
+  return _impl_.offsets_.size();
+}
+inline int ChainEdges::offsets_size() const {
+  return _internal_offsets_size();
+}
+inline void ChainEdges::clear_offsets() {
+  _impl_.offsets_.Clear();
+}
+inline uint32_t ChainEdges::_internal_offsets(int index) const {
+  return _impl_.offsets_.Get(index);
+}
+inline uint32_t ChainEdges::offsets(int index) const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.ChainEdges.offsets)
+  return _internal_offsets(index);
+}
+inline void ChainEdges::set_offsets(int index, uint32_t value) {
+  _impl_.offsets_.Set(index, value);
+  // @@protoc_insertion_point(field_set:transport_router_serialize.ChainEdges.offsets)
+}
+inline void ChainEdges::_internal_add_offsets(uint32_t value) {
+  _impl_.offsets_.Add(value);
+}
+inline void ChainEdges::add_offsets(uint32_t value) {
+  _internal_add_offsets(value);
+  // @@protoc_insertion_point(field_add:transport_router_serialize.ChainEdges.offsets)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+ChainEdges::_internal_offsets() const {
+  return _impl_.offsets_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+ChainEdges::offsets() const {
+  // @@protoc_insertion_point(field_list:transport_router_serialize.ChainEdges.offsets)
+  return _internal_offsets();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+ChainEdges::_internal_mutable_offsets() {
+  return &_impl_.offsets_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+ChainEdges::mutable_offsets() {
+  // @@protoc_insertion_point(field_mutable_list:transport_router_serialize.ChainEdges.offsets)
+  return _internal_mutable_offsets();
+}
+
+// repeated .graph_serialize.RouteWeight weights = 3;
+inline int ChainEdges::_internal_weights_size() const {
+  return _impl_.weights_.size();
+}
+inline int ChainEdges::weights_size() const {
+  return _internal_weights_size();
+}
+inline ::graph_serialize::RouteWeight* ChainEdges::mutable_weights(int index) {
+  // @@protoc_insertion_point(field_mutable:transport_router_serialize.ChainEdges.weights)
+  return _impl_.weights_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::RouteWeight >*
+ChainEdges::mutable_weights() {
+  // @@protoc_insertion_point(field_mutable_list:transport_router_serialize.ChainEdges.weights)
+  return &_impl_.weights_;
+}
+inline const ::graph_serialize::RouteWeight& ChainEdges::_internal_weights(int index) const {
+  return _impl_.weights_.Get(index);
+}
+inline const ::graph_serialize::RouteWeight& ChainEdges::weights(int index) const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.ChainEdges.weights)
+  return _internal_weights(index);
+}
+inline ::graph_serialize::RouteWeight* ChainEdges::_internal_add_weights() {
+  return _impl_.weights_.Add();
+}
+inline ::graph_serialize::RouteWeight* ChainEdges::add_weights() {
+  ::graph_serialize::RouteWeight* _add = _internal_add_weights();
+  // @@protoc_insertion_point(field_add:transport_router_serialize.ChainEdges.weights)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::graph_serialize::RouteWeight >&
+ChainEdges::weights() const {
+  // @@protoc_insertion_point(field_list:transport_router_serialize.ChainEdges.weights)
+  return _impl_.weights_;
+}
+
+// -------------------------------------------------------------------
+
 // TransportRouter
 
 // .transport_router_serialize.RouteSettings settings = 1;
@@ -997,6 +1659,266 @@ inline void TransportRouter::set_allocated_router(::graph_serialize::Router* rou
   // @@protoc_insertion_point(field_set_allocated:transport_router_serialize.TransportRouter.router)
 }
 
+// .graph_serialize.ContractionHierarchy contraction_hierarchy = 5;
+inline bool TransportRouter::_internal_has_contraction_hierarchy() const {
+  return this != internal_default_instance() && _impl_.contraction_hierarchy_ != nullptr;
+}
+inline bool TransportRouter::has_contraction_hierarchy() const {
+  return _internal_has_contraction_hierarchy();
+}
+inline const ::graph_serialize::ContractionHierarchy& TransportRouter::_internal_contraction_hierarchy() const {
+  const ::graph_serialize::ContractionHierarchy* p = _impl_.contraction_hierarchy_;
+  return p != nullptr ? *p : reinterpret_cast<const ::graph_serialize::ContractionHierarchy&>(
+      ::graph_serialize::_ContractionHierarchy_default_instance_);
+}
+inline const ::graph_serialize::ContractionHierarchy& TransportRouter::contraction_hierarchy() const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.TransportRouter.contraction_hierarchy)
+  return _internal_contraction_hierarchy();
+}
+inline void TransportRouter::unsafe_arena_set_allocated_contraction_hierarchy(
+    ::graph_serialize::ContractionHierarchy* contraction_hierarchy) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.contraction_hierarchy_);
+  }
+  _impl_.contraction_hierarchy_ = contraction_hierarchy;
+  if (contraction_hierarchy) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:transport_router_serialize.TransportRouter.contraction_hierarchy)
+}
+inline ::graph_serialize::ContractionHierarchy* TransportRouter::release_contraction_hierarchy() {
+  
+  ::graph_serialize::ContractionHierarchy* temp = _impl_.contraction_hierarchy_;
+  _impl_.contraction_hierarchy_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::graph_serialize::ContractionHierarchy* TransportRouter::unsafe_arena_release_contraction_hierarchy() {
+  // @@protoc_insertion_point(field_release:transport_router_serialize.TransportRouter.contraction_hierarchy)
+  
+  ::graph_serialize::ContractionHierarchy* temp = _impl_.contraction_hierarchy_;
+  _impl_.contraction_hierarchy_ = nullptr;
+  return temp;
+}
+inline ::graph_serialize::ContractionHierarchy* TransportRouter::_internal_mutable_contraction_hierarchy() {
+  
+  if (_impl_.contraction_hierarchy_ == nullptr) {
+    auto* p = CreateMaybeMessage<::graph_serialize::ContractionHierarchy>(GetArenaForAllocation());
+    _impl_.contraction_hierarchy_ = p;
+  }
+  return _impl_.contraction_hierarchy_;
+}
+inline ::graph_serialize::ContractionHierarchy* TransportRouter::mutable_contraction_hierarchy() {
+  ::graph_serialize::ContractionHierarchy* _msg = _internal_mutable_contraction_hierarchy();
+  // @@protoc_insertion_point(field_mutable:transport_router_serialize.TransportRouter.contraction_hierarchy)
+  return _msg;
+}
+inline void TransportRouter::set_allocated_contraction_hierarchy(::graph_serialize::ContractionHierarchy* contraction_hierarchy) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete reinterpret_cast< ::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.contraction_hierarchy_);
+  }
+  if (contraction_hierarchy) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(
+                reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(contraction_hierarchy));
+    if (message_arena != submessage_arena) {
+      contraction_hierarchy = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, contraction_hierarchy, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  _impl_.contraction_hierarchy_ = contraction_hierarchy;
+  // @@protoc_insertion_point(field_set_allocated:transport_router_serialize.TransportRouter.contraction_hierarchy)
+}
+
+// .graph_serialize.HubLabels hub_labels = 6;
+inline bool TransportRouter::_internal_has_hub_labels() const {
+  return this != internal_default_instance() && _impl_.hub_labels_ != nullptr;
+}
+inline bool TransportRouter::has_hub_labels() const {
+  return _internal_has_hub_labels();
+}
+inline const ::graph_serialize::HubLabels& TransportRouter::_internal_hub_labels() const {
+  const ::graph_serialize::HubLabels* p = _impl_.hub_labels_;
+  return p != nullptr ? *p : reinterpret_cast<const ::graph_serialize::HubLabels&>(
+      ::graph_serialize::_HubLabels_default_instance_);
+}
+inline const ::graph_serialize::HubLabels& TransportRouter::hub_labels() const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.TransportRouter.hub_labels)
+  return _internal_hub_labels();
+}
+inline void TransportRouter::unsafe_arena_set_allocated_hub_labels(
+    ::graph_serialize::HubLabels* hub_labels) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.hub_labels_);
+  }
+  _impl_.hub_labels_ = hub_labels;
+  if (hub_labels) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:transport_router_serialize.TransportRouter.hub_labels)
+}
+inline ::graph_serialize::HubLabels* TransportRouter::release_hub_labels() {
+  
+  ::graph_serialize::HubLabels* temp = _impl_.hub_labels_;
+  _impl_.hub_labels_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::graph_serialize::HubLabels* TransportRouter::unsafe_arena_release_hub_labels() {
+  // @@protoc_insertion_point(field_release:transport_router_serialize.TransportRouter.hub_labels)
+  
+  ::graph_serialize::HubLabels* temp = _impl_.hub_labels_;
+  _impl_.hub_labels_ = nullptr;
+  return temp;
+}
+inline ::graph_serialize::HubLabels* TransportRouter::_internal_mutable_hub_labels() {
+  
+  if (_impl_.hub_labels_ == nullptr) {
+    auto* p = CreateMaybeMessage<::graph_serialize::HubLabels>(GetArenaForAllocation());
+    _impl_.hub_labels_ = p;
+  }
+  return _impl_.hub_labels_;
+}
+inline ::graph_serialize::HubLabels* TransportRouter::mutable_hub_labels() {
+  ::graph_serialize::HubLabels* _msg = _internal_mutable_hub_labels();
+  // @@protoc_insertion_point(field_mutable:transport_router_serialize.TransportRouter.hub_labels)
+  return _msg;
+}
+inline void TransportRouter::set_allocated_hub_labels(::graph_serialize::HubLabels* hub_labels) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete reinterpret_cast< ::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.hub_labels_);
+  }
+  if (hub_labels) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(
+                reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(hub_labels));
+    if (message_arena != submessage_arena) {
+      hub_labels = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, hub_labels, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  _impl_.hub_labels_ = hub_labels;
+  // @@protoc_insertion_point(field_set_allocated:transport_router_serialize.TransportRouter.hub_labels)
+}
+
+// .transport_router_serialize.ChainEdges chain_edges = 7;
+inline bool TransportRouter::_internal_has_chain_edges() const {
+  return this != internal_default_instance() && _impl_.chain_edges_ != nullptr;
+}
+inline bool TransportRouter::has_chain_edges() const {
+  return _internal_has_chain_edges();
+}
+inline void TransportRouter::clear_chain_edges() {
+  if (GetArenaForAllocation() == nullptr && _impl_.chain_edges_ != nullptr) {
+    delete _impl_.chain_edges_;
+  }
+  _impl_.chain_edges_ = nullptr;
+}
+inline const ::transport_router_serialize::ChainEdges& TransportRouter::_internal_chain_edges() const {
+  const ::transport_router_serialize::ChainEdges* p = _impl_.chain_edges_;
+  return p != nullptr ? *p : reinterpret_cast<const ::transport_router_serialize::ChainEdges&>(
+      ::transport_router_serialize::_ChainEdges_default_instance_);
+}
+inline const ::transport_router_serialize::ChainEdges& TransportRouter::chain_edges() const {
+  // @@protoc_insertion_point(field_get:transport_router_serialize.TransportRouter.chain_edges)
+  return _internal_chain_edges();
+}
+inline void TransportRouter::unsafe_arena_set_allocated_chain_edges(
+    ::transport_router_serialize::ChainEdges* chain_edges) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.chain_edges_);
+  }
+  _impl_.chain_edges_ = chain_edges;
+  if (chain_edges) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:transport_router_serialize.TransportRouter.chain_edges)
+}
+inline ::transport_router_serialize::ChainEdges* TransportRouter::release_chain_edges() {
+  
+  ::transport_router_serialize::ChainEdges* temp = _impl_.chain_edges_;
+  _impl_.chain_edges_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::transport_router_serialize::ChainEdges* TransportRouter::unsafe_arena_release_chain_edges() {
+  // @@protoc_insertion_point(field_release:transport_router_serialize.TransportRouter.chain_edges)
+  
+  ::transport_router_serialize::ChainEdges* temp = _impl_.chain_edges_;
+  _impl_.chain_edges_ = nullptr;
+  return temp;
+}
+inline ::transport_router_serialize::ChainEdges* TransportRouter::_internal_mutable_chain_edges() {
+  
+  if (_impl_.chain_edges_ == nullptr) {
+    auto* p = CreateMaybeMessage<::transport_router_serialize::ChainEdges>(GetArenaForAllocation());
+    _impl_.chain_edges_ = p;
+  }
+  return _impl_.chain_edges_;
+}
+inline ::transport_router_serialize::ChainEdges* TransportRouter::mutable_chain_edges() {
+  ::transport_router_serialize::ChainEdges* _msg = _internal_mutable_chain_edges();
+  // @@protoc_insertion_point(field_mutable:transport_router_serialize.TransportRouter.chain_edges)
+  return _msg;
+}
+inline void TransportRouter::set_allocated_chain_edges(::transport_router_serialize::ChainEdges* chain_edges) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.chain_edges_;
+  }
+  if (chain_edges) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(chain_edges);
+    if (message_arena != submessage_arena) {
+      chain_edges = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, chain_edges, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  _impl_.chain_edges_ = chain_edges;
+  // @@protoc_insertion_point(field_set_allocated:transport_router_serialize.TransportRouter.chain_edges)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -1004,11 +1926,33 @@ inline void TransportRouter::set_allocated_router(::graph_serialize::Router* rou
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
 }  // namespace transport_router_serialize
 
+PROTOBUF_NAMESPACE_OPEN
+
+template <> struct is_proto_enum< ::transport_router_serialize::RoutingEngine> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::transport_router_serialize::RoutingEngine>() {
+  return ::transport_router_serialize::RoutingEngine_descriptor();
+}
+template <> struct is_proto_enum< ::transport_router_serialize::GraphModel> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::transport_router_serialize::GraphModel>() {
+  return ::transport_router_serialize::GraphModel_descriptor();
+}
+template <> struct is_proto_enum< ::transport_router_serialize::AllPairsAlgorithm> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::transport_router_serialize::AllPairsAlgorithm>() {
+  return ::transport_router_serialize::AllPairsAlgorithm_descriptor();
+}
+
+PROTOBUF_NAMESPACE_CLOSE
+
 // @@protoc_insertion_point(global_scope)
 
 #include <google/protobuf/port_undef.inc>